@@ -1,20 +1,60 @@
 #pragma once
 
 #include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "raylib.h"
 
 namespace GUI
 {
-  #define SEGMENTS 10
-  #define SPACING 1
+  constexpr int SEGMENTS = 10;
+  constexpr float SPACING = 1;
+  // Default text limit of an input, typed and pasted text past it is dropped
+  constexpr size_t INPUT_MAX_BYTES = 64*1024;
+
+  namespace Stats
+  {
+    // Heap activity of the calling thread, only counted when built with GUI_COUNT_ALLOCATIONS
+    extern thread_local size_t allocationsThisFrame;
+    extern thread_local size_t bytesThisFrame;
+    extern thread_local size_t allocationsTotal;
+
+    void BeginFrame(void) noexcept;
+    size_t EndFrame(void) noexcept;
+  }
+
+  class Animator;
+  class ClipStack;
+  class TextBatcher;
+  class FocusManager;
+  class EventQueue;
+  class MemoryReport;
+  class TileRenderer;
 
   typedef struct MouseState
   {
     Vector2 position;
     bool clicked;
+    // Left button this frame, set by the host from raylib or a GUI::RemoteServer
+    bool pressed;
+    bool down;
     MouseCursor cursor;
+    GUI::Animator* animator;
+    GUI::ClipStack* clip;
+    GUI::TextBatcher* textBatcher;
+    GUI::FocusManager* focus;
+    GUI::EventQueue* events;
+    // Set for frames drawn by GUI::Software, widgets record into it instead of drawing with raylib
+    GUI::TileRenderer* tiles;
   } MouseState;
 
   enum TextAlignments : uint8_t
@@ -40,6 +80,11 @@ namespace GUI
     float outlineDistance;
     bool  outlineFill;
     float hoverScale;
+    float hoverOutlineOffset;
+    float transitionTime;
+    // Icons are drawn this high, the font size when 0, and this far from the label
+    float iconSize;
+    float iconSpacing;
   } ButtonStyle;
 
   typedef struct InputStyle
@@ -62,51 +107,1502 @@ namespace GUI
     float outlineThickness;
     float outlineDistance;
     bool  outlineFill;
+    float transitionTime;
+    Color invalidOutlineColor;
   } InputStyle;
 
+  typedef uint16_t StyleHandle;
+
+  namespace Styles
+  {
+    // Shared table of input styles, identical styles are stored once and widgets keep a 2 byte handle.
+    // Handle 0 is a zeroed style and entries never move, so references stay valid.
+    // Interning is serialized and lookups take no lock, so widgets can be built on several threads.
+    GUI::StyleHandle InternInput(const GUI::InputStyle& style);
+    const GUI::InputStyle& GetInput(GUI::StyleHandle handle) noexcept;
+    void ReportMemory(GUI::MemoryReport& report);
+  }
+
+  typedef struct MemoryEntry
+  {
+    std::string category;
+    std::string name;
+    size_t count;
+    size_t bytes;
+  } MemoryEntry;
+
+  // Bytes held by widgets, styles, fonts and caches, each object adds its own entries through ReportMemory
+  class MemoryReport
+  {
+  public:
+    MemoryReport(void);
+
+    void Add(const char* category, const std::string& name, size_t bytes, size_t count = 1);
+    void Clear(void) noexcept;
+    const std::vector<GUI::MemoryEntry>& GetEntries(void) const noexcept;
+    size_t GetTotal(void) const noexcept;
+    size_t GetTotal(const char* category) const noexcept;
+    void Log(void) const;
+
+  private:
+    std::vector<GUI::MemoryEntry> m_Entries;
+    size_t m_LastEntry;
+  };
+
+  typedef struct Tween
+  {
+    float* target;
+    float from;
+    float to;
+    float elapsed;
+    float duration;
+  } Tween;
+
+  // Runs only the transitions in flight, an idle animator costs nothing and lets the loop sleep
+  class Animator
+  {
+  public:
+    Animator(void);
+
+    void Animate(float* target, float to, float duration) noexcept;
+    void Cancel(const float* target) noexcept;
+    void Update(float deltaTime) noexcept;
+    bool IsAnimating(void) const noexcept;
+    float GetNextWakeup(void) const noexcept;
+    // Keeps GetNextWakeup at 0 until the next Update, for widgets that need frames without a tween
+    void RequestFrame(void) noexcept;
+
+  private:
+    std::vector<GUI::Tween> m_Tweens;
+    bool m_FrameRequested;
+  };
+
+  Color LerpColor(Color from, Color to, float amount) noexcept;
+
+  constexpr size_t THEME_SLOTS = 256;
+
+  typedef struct Theme
+  {
+    Color colors[THEME_SLOTS];
+  } Theme;
+
+  // A style color made by PaletteColor names a slot of the active theme and is looked up when drawn,
+  // so applying another theme retints every widget without touching their styles.
+  // The marker is a fully transparent color, which never draws anything on its own.
+  constexpr Color PaletteColor(uint8_t slot) noexcept
+  {
+    return { slot, 0x50, 0x4C, 0 };
+  }
+
+  constexpr bool IsPaletteColor(Color color) noexcept
+  {
+    return color.a == 0 && color.g == 0x50 && color.b == 0x4C;
+  }
+
+  Color ResolveColor(Color color) noexcept;
+  void ApplyTheme(const GUI::Theme* theme) noexcept;
+  const GUI::Theme* GetTheme(void) noexcept;
+  uint32_t GetThemeGeneration(void) noexcept;
+
+  enum SurfaceBackends : uint8_t
+  {
+    SURFACE_BACKEND_GPU = 0,
+    SURFACE_BACKEND_CPU,
+  };
+
+  typedef struct SurfaceSlot
+  {
+    Rectangle region;
+    Vector2 origin;
+    uint32_t generation;
+    bool valid;
+  } SurfaceSlot;
+
+  namespace Software
+  {
+    // CPU versions of the raylib primitives the widgets use, drawing into an R8G8B8A8 image.
+    // Rows are split into solid spans and anti-aliased edges, both filled and blended with SSE2 or AVX2 when the target has them.
+    // Only pixels whose center is inside clip are touched, which is how tiles rasterize their part of a shape.
+    void DrawRectangle(Image& image, Rectangle rec, Color color, const Rectangle* clip = nullptr) noexcept;
+    void DrawRectangleRounded(Image& image, Rectangle rec, float roundness, Color color, const Rectangle* clip = nullptr) noexcept;
+    void DrawRectangleRoundedLines(Image& image, Rectangle rec, float roundness, float lineThickness, Color color, const Rectangle* clip = nullptr) noexcept;
+    void DrawTextEx(Image& image, const Image& atlas, Font font, const char* text, Vector2 position, float fontSize, float spacing, Color tint, const Rectangle* clip = nullptr) noexcept;
+    void DrawImage(Image& image, const Image& source, Rectangle sourceRec, Rectangle dest, Color tint, const Rectangle* clip = nullptr) noexcept;
+    Rectangle MeasureTextBounds(Font font, const char* text, Vector2 position, float fontSize, float spacing) noexcept;
+
+    // Rasterizes a font into glyphs and a gray+alpha atlas without a window, the font has no texture
+    bool LoadFont(const char* fileName, int fontSize, Font& font, Image& atlas) noexcept;
+    void UnloadFont(Font& font, Image& atlas) noexcept;
+  }
+
+  // Nested clip rects applied on the CPU, so clipped quads stay in the current batch instead of flushing it for a scissor.
+  // An empty stack clips nothing.
+  class ClipStack
+  {
+  public:
+    ClipStack(void);
+
+    void Push(Rectangle rec) noexcept;
+    void Pop(void) noexcept;
+    bool IsEmpty(void) const noexcept;
+    Rectangle GetRect(void) const noexcept;
+    bool IsVisible(Rectangle rec) const noexcept;
+    bool ClipQuad(Rectangle& source, Rectangle& dest) const noexcept;
+
+    void DrawRectangle(Rectangle rec, Color color) const noexcept;
+    void DrawTexture(Texture2D texture, Rectangle source, Rectangle dest, Color tint) const noexcept;
+    void DrawTextEx(Font font, const char* text, Vector2 position, float fontSize, float spacing, Color tint) const noexcept;
+
+    // Fallback for shapes that cannot be trimmed as quads, this flushes the batch like BeginScissorMode
+    void BeginScissor(void) const noexcept;
+    void EndScissor(void) const noexcept;
+
+  private:
+    static constexpr size_t MAX_DEPTH = 16;
+
+    Rectangle m_Rects[MAX_DEPTH];
+    size_t m_Depth;
+    size_t m_Overflow;
+  };
+
+  typedef struct GlyphQuad
+  {
+    Rectangle source;
+    Rectangle dest;
+    Color tint;
+  } GlyphQuad;
+
+  // Glyph and icon quads from every widget, grouped per atlas and submitted after the shapes so text and icons cost one batch per atlas
+  class TextBatcher
+  {
+  public:
+    TextBatcher(void);
+
+    void AddText(Font font, const char* text, Vector2 position, float fontSize, float spacing, Color tint, const GUI::ClipStack* clip = nullptr);
+    void AddQuad(Texture2D texture, Rectangle source, Rectangle dest, Color tint, const GUI::ClipStack* clip = nullptr);
+    // Premultiplied quads, like GUI::SurfaceCache blits, are drawn under one blend mode before the rest
+    void AddSurface(Texture2D texture, Rectangle source, Rectangle dest);
+    void Flush(void) noexcept;
+    size_t GetQuadCount(void) const noexcept;
+    void ReportMemory(GUI::MemoryReport& report) const;
+
+  private:
+    typedef struct Batch
+    {
+      Texture2D texture;
+      bool premultiplied;
+      std::vector<GUI::GlyphQuad> quads;
+    } Batch;
+
+    std::vector<Batch> m_Batches;
+    size_t m_LastBatch;
+
+  private:
+    std::vector<GUI::GlyphQuad>& GetQuads(Texture2D texture, bool premultiplied);
+  };
+
+  // Owns keyboard focus. The frame's key and char queues are drained once and only the focused widget reads them,
+  // Tab and Shift+Tab walk widgets in the order they registered.
+  // Keys from elsewhere, like a GUI::RemoteServer, are pushed after BeginFrame and read the same way as raylib's.
+  class FocusManager
+  {
+  public:
+    FocusManager(void);
+
+    void BeginFrame(void) noexcept;
+    void EndFrame(const GUI::MouseState& mouseState) noexcept;
+
+    void Register(const void* widget);
+    void Unregister(const void* widget) noexcept;
+    void SetFocus(const void* widget) noexcept;
+    void ClearFocus(void) noexcept;
+    bool HasFocus(const void* widget) const noexcept;
+    const void* GetFocused(void) const noexcept;
+    void FocusNext(bool reverse) noexcept;
+
+    size_t GetKeyCount(void) const noexcept;
+    const int* GetKeys(void) const noexcept;
+    size_t GetCharCount(void) const noexcept;
+    const int* GetChars(void) const noexcept;
+    void ConsumeKey(int key) noexcept;
+    void PushKey(int key) noexcept;
+    void PushChar(int codepoint) noexcept;
+    void SetKeyDown(int key, bool down) noexcept;
+    bool IsKeyPressed(int key) const noexcept;
+    bool IsKeyDown(int key) const noexcept;
+
+  private:
+    static constexpr size_t MAX_EVENTS = 32;
+    static constexpr int MAX_KEYS = 384;
+
+    // Registration order with nullptr holes, and each widget's slot in it
+    std::vector<const void*> m_Order;
+    std::unordered_map<const void*, size_t> m_Positions;
+    size_t m_Holes;
+    const void* m_Focused;
+    bool m_FocusClaimed;
+    int m_Keys[MAX_EVENTS];
+    size_t m_KeyCount;
+    int m_Chars[MAX_EVENTS];
+    size_t m_CharCount;
+    uint64_t m_KeysDown[MAX_KEYS/64];
+  };
+
+  enum EventTypes : uint8_t
+  {
+    EVENT_CLICK = 0,
+    EVENT_HOVER_ENTER,
+    EVENT_HOVER_LEAVE,
+    EVENT_TEXT_CHANGED,
+    EVENT_SUBMIT,
+    EVENT_FOCUS,
+    EVENT_BLUR,
+    EVENT_TYPE_COUNT,
+  };
+
+  typedef struct Event
+  {
+    GUI::EventTypes type;
+    const void* widget;
+  } Event;
+
+  typedef void (*EventHandler)(const GUI::Event& event, void* userData);
+
+  // Widgets queue events while they update, Dispatch delivers the frame's events in one pass afterwards.
+  // Handlers are kept per event type sorted by widget, so only handlers whose event fired are ever visited.
+  class EventQueue
+  {
+  public:
+    EventQueue(void);
+
+    // A null widget receives the event type from every widget
+    void AddHandler(GUI::EventTypes type, const void* widget, GUI::EventHandler handler, void* userData);
+    void RemoveHandlers(const void* widget) noexcept;
+    void Push(GUI::EventTypes type, const void* widget);
+    void Dispatch(void);
+    size_t GetEventCount(void) const noexcept;
+
+  private:
+    typedef struct Handler
+    {
+      const void* widget;
+      GUI::EventHandler handler;
+      void* userData;
+    } Handler;
+
+    std::vector<Handler> m_Handlers[EVENT_TYPE_COUNT];
+    std::vector<GUI::Event> m_Events;
+    std::vector<GUI::Event> m_Dispatching;
+
+  private:
+    void Deliver(const GUI::Event& event, const void* widget);
+  };
+
+  // Atlas of pre-rendered widget states, widgets blit one quad from it instead of redrawing their primitives.
+  // When its widgets need more room than it has, new surfaces are refused until Clear and those widgets draw directly.
+  // Given a GUI::TextBatcher, GPU surfaces are drawn with it on Flush, over the frame's shapes and under its text.
+  class SurfaceCache
+  {
+  public:
+    SurfaceCache(void);
+    SurfaceCache(int width, int height, GUI::SurfaceBackends backend);
+    SurfaceCache(const SurfaceCache&) = delete;
+    SurfaceCache& operator=(const SurfaceCache&) = delete;
+    ~SurfaceCache(void);
+
+    bool Acquire(GUI::SurfaceSlot& slot, int width, int height, GUI::TextBatcher* textBatcher = nullptr) noexcept;
+    bool IsResident(const GUI::SurfaceSlot& slot) const noexcept;
+    void BeginSurface(const GUI::SurfaceSlot& slot) noexcept;
+    void EndSurface(void) noexcept;
+    void DrawSurface(const GUI::SurfaceSlot& slot, GUI::TextBatcher* textBatcher = nullptr);
+    void Clear(void) noexcept;
+
+    GUI::SurfaceBackends GetBackend(void) const noexcept;
+    GUI::TileRenderer& GetTiles(void) noexcept;
+    const Image& GetFontAtlas(const Font& font) noexcept;
+    void ReportMemory(GUI::MemoryReport& report) const;
+
+  private:
+    struct FontAtlas
+    {
+      unsigned int textureId;
+      Image image;
+    };
+
+    int m_Width;
+    int m_Height;
+    GUI::SurfaceBackends m_Backend;
+    RenderTexture2D m_Target;
+    Image m_Image;
+    Texture2D m_Texture;
+    bool m_TextureDirty;
+    // CPU surfaces are recorded here between BeginSurface and EndSurface
+    std::unique_ptr<GUI::TileRenderer> m_Tiles;
+    std::vector<FontAtlas> m_FontAtlases;
+    uint32_t m_Generation;
+    int m_ShelfX;
+    int m_ShelfY;
+    int m_ShelfHeight;
+    // Since the last Clear, a full atlas with no surface drawn more than once is thrashing
+    uint32_t m_Allocations;
+    uint32_t m_Draws;
+    bool m_Overflowed;
+
+  private:
+    void Load(void) noexcept;
+  };
+
+  // Generation in the high 16 bits and slot+1 in the low ones, 0 is no icon
+  typedef uint32_t IconHandle;
+
+  // Icons and images packed into one texture at runtime, so every widget drawing from it stays in the same batch.
+  // A skyline packer places them bottom-left with extruded padding so bilinear filtering never samples a neighbour.
+  // Removed images leave holes, once an Add no longer fits the live images are repacked tallest first.
+  // Handles stay valid across repacks, only the regions behind them move.
+  class AtlasPacker
+  {
+  public:
+    AtlasPacker(void);
+    AtlasPacker(int width, int height, int padding);
+    ~AtlasPacker(void);
+
+    AtlasPacker(const AtlasPacker&) = delete;
+    AtlasPacker& operator=(const AtlasPacker&) = delete;
+
+    GUI::IconHandle Add(const Image& image);
+    GUI::IconHandle Load(const char* fileName);
+    void Remove(GUI::IconHandle icon) noexcept;
+    bool Repack(void);
+    Rectangle GetRegion(GUI::IconHandle icon) const noexcept;
+    Texture2D GetTexture(void) noexcept;
+    const Image& GetImage(void) const noexcept;
+    size_t GetCount(void) const noexcept;
+    size_t GetRepackCount(void) const noexcept;
+    void ReportMemory(GUI::MemoryReport& report) const;
+
+  private:
+    struct Entry
+    {
+      Rectangle region;
+      uint16_t generation;
+      bool used;
+    };
+
+    struct SkylineNode
+    {
+      int x;
+      int y;
+      int width;
+    };
+
+    int m_Width;
+    int m_Height;
+    int m_Padding;
+    Image m_Image;
+    Texture2D m_Texture;
+    bool m_TextureDirty;
+    std::vector<Entry> m_Entries;
+    std::vector<SkylineNode> m_Skyline;
+    size_t m_Count;
+    size_t m_FreedArea;
+    size_t m_RepackCount;
+
+  private:
+    bool Place(std::vector<SkylineNode>& skyline, int width, int height, int& x, int& y) const;
+    void Blit(const unsigned char* pixels, int stride, int sourceX, int sourceY, int width, int height, int x, int y) noexcept;
+  };
+
+  typedef size_t FontHandle;
+
+  // Owns the UI scale factor, sizes are scaled once when styles, bounds and fonts are baked instead of per draw.
+  // Update returns true after rebaking, the fonts it replaced stay loaded until the next Update so styles can be re-applied first.
+  class Context
+  {
+  public:
+    Context(void);
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+    ~Context(void);
+
+    bool Update(void) noexcept;
+    void SetScale(float scale) noexcept;
+    float GetScale(void) const noexcept;
+
+    GUI::FontHandle LoadFont(const std::string& fileName, float fontSize);
+    Font GetFont(GUI::FontHandle font) const noexcept;
+    void ReportMemory(GUI::MemoryReport& report) const;
+
+    float Scale(float value) const noexcept;
+    Rectangle Scale(Rectangle bounds) const noexcept;
+    GUI::ButtonStyle Scale(GUI::ButtonStyle style, GUI::FontHandle font) const noexcept;
+    GUI::InputStyle Scale(GUI::InputStyle style, GUI::FontHandle font) const noexcept;
+
+  private:
+    struct FontEntry
+    {
+      std::string fileName;
+      float fontSize;
+      int bakedSize;
+      Font font;
+    };
+
+    std::vector<FontEntry> m_Fonts;
+    std::vector<Font> m_RetiredFonts;
+    float m_Scale;
+    bool m_AutoScale;
+
+  private:
+    float GetMonitorScale(void) const noexcept;
+    bool BakeFonts(void) noexcept;
+    void UnloadRetiredFonts(void) noexcept;
+  };
+
   class Button
   {
   public:
     Button(void);
     Button(Rectangle bounds, GUI::ButtonStyle style, const std::string& text);
+    ~Button(void);
 
     bool UpdateAndRender(GUI::MouseState& mouseState);
+    void SetBounds(Rectangle bounds) noexcept;
+    void SetStyle(const GUI::ButtonStyle& style) noexcept;
+    void SetText(const std::string& text) noexcept;
+    void SetSurfaceCache(GUI::SurfaceCache* surfaceCache) noexcept;
+    void SetIcon(GUI::AtlasPacker* atlas, GUI::IconHandle icon) noexcept;
+    const GUI::ButtonStyle& GetStyle(void) const noexcept;
+    void DrawToTiles(GUI::TileRenderer& tiles);
+    void ReportMemory(GUI::MemoryReport& report) const;
 
   private:
     Rectangle m_Bounds;
     GUI::ButtonStyle m_Style;
     std::string m_Text;
+    GUI::SurfaceCache* m_SurfaceCache;
+    GUI::AtlasPacker* m_Atlas;
+    GUI::IconHandle m_Icon;
+    GUI::SurfaceSlot m_Surfaces[2];
+    GUI::Animator* m_Animator;
+    float m_HoverProgress;
+    bool m_Hovered;
+    bool m_UsesPalette;
+    uint32_t m_ThemeGeneration;
+
+  private:
+    void Render(Rectangle bounds, Vector2 offset, float outlineDistance, Color backgroundColor, Color outlineColor, Color textColor, GUI::TextBatcher* textBatcher) noexcept;
+    void RenderSoftware(GUI::TileRenderer& tiles, const Image& atlas, Rectangle bounds, Vector2 offset, float outlineDistance, Color backgroundColor, Color outlineColor, Color textColor);
+    Vector2 GetTextPosition(Vector2 offset) const noexcept;
+    Vector2 GetIconSize(void) const noexcept;
+    Rectangle GetIconBounds(Vector2 textPosition) const noexcept;
+    Rectangle GetSurfaceArea(Rectangle bounds, float outlineDistance) const noexcept;
+    void InvalidateSurfaces(void) noexcept;
+  };
+
+  // ButtonStyle without the font, usable as a constant expression by StaticButton
+  typedef struct StaticButtonStyle
+  {
+    Color baseBackgroundColor;
+    Color baseTextColor;
+    Color baseOutlineColor;
+    Color hoverBackgroundColor;
+    Color hoverTextColor;
+    Color hoverOutlineColor;
+    float fontSize;
+    int   textAlignment;
+    float roundness;
+    float outlineThickness;
+    float outlineDistance;
+    bool  outlineFill;
+    float hoverScale;
+    float hoverOutlineOffset;
+    float transitionTime;
+  } StaticButtonStyle;
+
+  // A Button whose style is fixed at compile time, the outline, alignment and transition branches fold away.
+  // With constexpr bounds the resting and hovered geometry is computed by the compiler as well.
+  template <const GUI::StaticButtonStyle& Style, const Rectangle* Bounds = nullptr>
+  class StaticButton
+  {
+  public:
+    StaticButton(Font font, const std::string& text, Rectangle bounds = Rectangle());
+    ~StaticButton(void);
+
+    StaticButton(const StaticButton&) = delete;
+    StaticButton& operator=(const StaticButton&) = delete;
+
+    bool UpdateAndRender(GUI::MouseState& mouseState) noexcept;
+    void SetText(const std::string& text);
+    void SetBounds(Rectangle bounds) noexcept;
+    void SetFont(Font font) noexcept;
+
+  private:
+    Font m_Font;
+    std::string m_Text;
+    Rectangle m_Bounds;
+    Vector2 m_TextPosition;
+    GUI::Animator* m_Animator;
+    float m_HoverProgress;
+
+  private:
+    static constexpr Rectangle Expand(Rectangle bounds, float distance) noexcept;
+    static constexpr Rectangle ScaleBounds(Rectangle bounds, float progress) noexcept;
+    static void Draw(Rectangle bounds, float outlineDistance, Color backgroundColor, Color outlineColor) noexcept;
+    void DrawLabel(GUI::MouseState& mouseState, Color textColor) const;
+    void UpdateTextPosition(void) noexcept;
+  };
+
+  namespace Utf8
+  {
+    size_t CountCodepoints(const char* text, size_t length) noexcept;
+    size_t PreviousCodepoint(const char* text, size_t index) noexcept;
+    size_t NextCodepoint(const char* text, size_t length, size_t index) noexcept;
+    size_t Sanitize(const char* text, size_t maxBytes, size_t maxCodepoints, std::string& out) noexcept;
+  }
+
+  namespace Text
+  {
+    // Same metrics as MeasureTextEx for a single line, without needing a terminated copy of the range
+    float MeasureRange(const Font& font, const char* text, size_t length, float fontSize, float spacing) noexcept;
+    size_t IndexAtX(const Font& font, const char* text, size_t length, float fontSize, float spacing, float x) noexcept;
+    // Call after unloading a font, the next font loaded can get the same addresses
+    void InvalidateGlyphTables(void) noexcept;
+  }
+
+  // Segment boundaries of a text as bitmaps, patched around each edit instead of rebuilt
+  class WordIndex
+  {
+  public:
+    WordIndex(void);
+
+    void Rebuild(const std::string& text) noexcept;
+    void Update(const std::string& text, size_t offset, size_t removed, size_t inserted) noexcept;
+    size_t PreviousWordStart(size_t index) const noexcept;
+    size_t NextWordEnd(size_t index) const noexcept;
+    void SegmentAt(size_t index, size_t& start, size_t& end) const noexcept;
+    size_t GetMemoryUsage(void) const noexcept;
+
+  private:
+    std::vector<uint64_t> m_Boundaries;
+    std::vector<uint64_t> m_WordStarts;
+    size_t m_Length;
+
+  private:
+    void Resize(size_t length) noexcept;
+    void Segment(const std::string& text, size_t start, size_t editEnd, bool full) noexcept;
+  };
+
+  // Header of one journal record, its bytes follow it in the journal's buffer
+  typedef struct EditDelta
+  {
+    size_t offset;
+    size_t length;
+    size_t cursor;
+    size_t previous;
+    bool insert;
+    // Undone and redone together with the delta before it
+    bool joined;
+  } EditDelta;
+
+  // Undo history stored as insert/erase deltas, consecutive typing coalesces and the records share one buffer capped at maxBytes
+  class EditJournal
+  {
+  public:
+    EditJournal(void);
+    EditJournal(size_t maxBytes);
+
+    void RecordInsert(size_t offset, const char* bytes, size_t length, size_t cursor, bool coalesce) noexcept;
+    void RecordErase(size_t offset, const char* bytes, size_t length, size_t cursor, bool coalesce) noexcept;
+    void Seal(void) noexcept;
+    // The next delta becomes one undo step with the newest one, for replacing text
+    void Join(void) noexcept;
+    bool Undo(std::string& text, size_t& cursor) noexcept;
+    bool Redo(std::string& text, size_t& cursor) noexcept;
+    void Clear(void) noexcept;
+    void SetMaxBytes(size_t maxBytes) noexcept;
+    size_t GetMemoryUsage(void) const noexcept;
+
+  private:
+    std::vector<char> m_Buffer;
+    // Where the redo tail starts, and the newest record before it
+    size_t m_Head;
+    size_t m_Last;
+    size_t m_MaxBytes;
+    bool m_Sealed;
+    bool m_Joining;
+
+  private:
+    GUI::EditDelta& At(size_t position) noexcept;
+    char* Data(size_t position) noexcept;
+    bool BeginRecord(size_t length) noexcept;
+    void DropRedo(void) noexcept;
+    void Trim(size_t needed, size_t keep) noexcept;
+    void Resize(size_t size) noexcept;
+    void Append(size_t offset, const char* bytes, size_t length, size_t cursor, bool insert, bool coalesce) noexcept;
+    void Extend(size_t length) noexcept;
+  };
+
+  namespace Patterns
+  {
+    constexpr const char* NUMERIC = "-?[0-9]+(\\.[0-9]+)?";
+    constexpr const char* IPV4    = "((25[0-5]|2[0-4][0-9]|1[0-9][0-9]|[1-9]?[0-9])\\.){3}(25[0-5]|2[0-4][0-9]|1[0-9][0-9]|[1-9]?[0-9])";
+    constexpr const char* TICKER  = "[A-Za-z]{1,5}(\\.[A-Za-z]{1,2})?";
+    constexpr const char* EMAIL   = "[A-Za-z0-9._%+-]+@[A-Za-z0-9-]+(\\.[A-Za-z0-9-]+)*\\.[A-Za-z]{2,}";
+  }
+
+  enum ValidationStates : uint8_t
+  {
+    VALIDATION_STATE_VALID = 0,
+    VALIDATION_STATE_INCOMPLETE,
+    VALIDATION_STATE_INVALID,
+  };
+
+  // A pattern compiled once into a byte-level DFA, state 0 is dead and state 1 is the start
+  class Validator
+  {
+  public:
+    Validator(void);
+    Validator(const char* pattern);
+
+    bool Compile(const char* pattern);
+    bool IsCompiled(void) const noexcept;
+    uint16_t Run(uint16_t state, const char* text, size_t length) const noexcept;
+    bool IsAccepting(uint16_t state) const noexcept;
+
+  private:
+    uint8_t m_ByteClasses[256];
+    size_t m_ClassCount;
+    std::vector<uint16_t> m_Transitions;
+    std::vector<bool> m_Accepting;
+  };
+
+  // Entries sorted case-insensitively in one blob, prefix lookups are two binary searches
+  class PrefixIndex
+  {
+  public:
+    void Build(const std::vector<std::string>& entries);
+    size_t GetSize(void) const noexcept;
+    std::string GetEntry(size_t index) const;
+    void Find(const char* prefix, size_t length, size_t& first, size_t& last) const noexcept;
+
+  private:
+    std::string m_Data;
+    std::vector<uint32_t> m_Offsets;
+  };
+
+  // Builds and queries a PrefixIndex on a worker thread, newer requests cancel older ones
+  // and finished results are published by Update at the start of a frame
+  class Autocomplete
+  {
+  public:
+    Autocomplete(void);
+    Autocomplete(size_t maxSuggestions);
+    ~Autocomplete(void);
+
+    Autocomplete(const Autocomplete&) = delete;
+    Autocomplete& operator=(const Autocomplete&) = delete;
+
+    void SetEntries(std::vector<std::string> entries) noexcept;
+    void Request(const void* owner, const std::string& prefix) noexcept;
+    void Cancel(const void* owner) noexcept;
+    void Update(void) noexcept;
+    bool IsPending(void) const noexcept;
+    const std::vector<std::string>& GetSuggestions(const void* owner, const std::string& prefix) const noexcept;
+
+  private:
+    size_t m_MaxSuggestions;
+    std::thread m_Thread;
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    std::atomic<uint32_t> m_Generation;
+
+    // Guarded by m_Mutex
+    std::vector<std::string> m_Entries;
+    std::string m_Query;
+    const void* m_QueryOwner;
+    uint32_t m_QueryGeneration;
+    bool m_HasQuery;
+    bool m_HasEntries;
+    bool m_Quit;
+    std::vector<std::string> m_Results;
+    std::string m_ResultPrefix;
+    const void* m_ResultOwner;
+    uint32_t m_ResultGeneration;
+    bool m_HasResults;
+
+    // UI thread only
+    std::vector<std::string> m_Suggestions;
+    std::string m_Prefix;
+    const void* m_Owner;
+    uint32_t m_PendingGeneration;
+
+  private:
+    void Run(void) noexcept;
+  };
+
+  // Fixed set of worker threads running submitted jobs in submission order
+  class ThreadPool
+  {
+  public:
+    ThreadPool(void);
+    ThreadPool(size_t threadCount);
+    ~ThreadPool(void);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Submit(std::function<void(void)> job);
+    void Wait(void) noexcept;
+    size_t GetThreadCount(void) const noexcept;
+
+  private:
+    std::vector<std::thread> m_Threads;
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    std::condition_variable m_Idle;
+
+    // Guarded by m_Mutex
+    std::deque<std::function<void(void)>> m_Jobs;
+    size_t m_Running;
+    bool m_Quit;
+
+  private:
+    void Run(void) noexcept;
+  };
+
+  constexpr int SOFTWARE_TILE_SIZE = 64;
+
+  typedef struct TileStats
+  {
+    size_t tileCount;
+    size_t activeTileCount;
+    size_t commandCount;
+    size_t binnedCount;
+    size_t threadCount;
+    float binMilliseconds;
+    float renderMilliseconds;
+    float averageTileMilliseconds;
+    float maxTileMilliseconds;
+  } TileStats;
+
+  // Records GUI::Software draws, bins them into screen tiles and rasterizes the tiles in parallel.
+  // Each tile runs its commands in recording order, so the image is the same as drawing them one after another.
+  class TileRenderer
+  {
+  public:
+    TileRenderer(void);
+    TileRenderer(int tileSize);
+
+    TileRenderer(const TileRenderer&) = delete;
+    TileRenderer& operator=(const TileRenderer&) = delete;
+
+    // Fonts loaded without a window have no texture, so atlases are matched on the glyph data
+    void AddFont(const Font& font, const Image& atlas);
+    const Image& GetFontAtlas(const Font& font) const noexcept;
+
+    void DrawRectangle(Rectangle rec, Color color, const Rectangle* clip = nullptr);
+    void DrawRectangleRounded(Rectangle rec, float roundness, Color color, const Rectangle* clip = nullptr);
+    void DrawRectangleRoundedLines(Rectangle rec, float roundness, float lineThickness, Color color, const Rectangle* clip = nullptr);
+    void DrawTextEx(const Image& atlas, Font font, const char* text, Vector2 position, float fontSize, float spacing, Color tint, const Rectangle* clip = nullptr);
+    void DrawImage(const Image& source, Rectangle sourceRec, Rectangle dest, Color tint, const Rectangle* clip = nullptr);
+    void Render(Image& image, GUI::ThreadPool* pool);
+    void Clear(void) noexcept;
+
+    const GUI::TileStats& GetStats(void) const noexcept;
+    const std::vector<float>& GetTileTimes(void) const noexcept;
+    int GetTileSize(void) const noexcept;
+
+  private:
+    enum CommandTypes : uint8_t
+    {
+      COMMAND_RECTANGLE = 0,
+      COMMAND_ROUNDED,
+      COMMAND_ROUNDED_LINES,
+      COMMAND_TEXT,
+      COMMAND_IMAGE,
+    };
+
+    struct FontAtlas
+    {
+      const GlyphInfo* glyphs;
+      const Image* atlas;
+    };
+
+    struct Command
+    {
+      CommandTypes type;
+      bool clipped;
+      Color color;
+      Rectangle rec;
+      Rectangle source;
+      Rectangle bounds;
+      Rectangle clip;
+      float roundness;
+      float lineThickness;
+      uint32_t text;
+      const Image* atlas;
+      Font font;
+    };
+
+    int m_TileSize;
+    int m_Columns;
+    int m_Rows;
+    std::vector<FontAtlas> m_Fonts;
+    std::vector<Command> m_Commands;
+    std::string m_Text;
+    std::vector<std::vector<uint32_t>> m_Bins;
+    std::vector<float> m_TileTimes;
+    GUI::TileStats m_Stats;
+
+  private:
+    void Record(Command& command, Rectangle bounds, const Rectangle* clip);
+    void Bin(const Image& image);
+    void RenderTile(Image& image, size_t tile) noexcept;
+  };
+
+  // Wire format between GUI::RemoteServer and GUI::RemoteClient, little-endian like the layout records.
+  // The server sends a RemoteHello once, after that every message is a RemoteMessage followed by its payload.
+  typedef struct RemoteHello
+  {
+    char     magic[4];
+    uint32_t version;
+  } RemoteHello;
+
+  enum RemoteMessageTypes : uint8_t
+  {
+    REMOTE_MESSAGE_FRAME = 0,
+    REMOTE_MESSAGE_MOUSE,
+    REMOTE_MESSAGE_KEY,
+    REMOTE_MESSAGE_CHAR,
   };
 
+  typedef struct RemoteMessage
+  {
+    uint8_t  type;
+    uint8_t  reserved[3];
+    uint32_t size;
+  } RemoteMessage;
+
+  // Followed by tileCount tiles, the tiles that did not change keep their pixels from earlier frames
+  typedef struct RemoteFrame
+  {
+    uint32_t frame;
+    uint16_t width;
+    uint16_t height;
+    uint16_t tileSize;
+    uint16_t reserved;
+    uint32_t tileCount;
+  } RemoteFrame;
+
+  // Followed by size bytes of RGBA pixels in PackBits runs, a control byte below 128 copies that many plus one pixels,
+  // anything above repeats the next pixel control-126 times
+  typedef struct RemoteTile
+  {
+    uint16_t column;
+    uint16_t row;
+    uint32_t size;
+  } RemoteTile;
+
+  typedef struct RemoteMouse
+  {
+    float   x;
+    float   y;
+    uint8_t down;
+    uint8_t reserved[3];
+  } RemoteMouse;
+
+  typedef struct RemoteKey
+  {
+    int32_t key;
+    uint8_t down;
+    uint8_t reserved[3];
+  } RemoteKey;
+
+  typedef struct RemoteChar
+  {
+    int32_t codepoint;
+  } RemoteChar;
+
+  #define REMOTE_VERSION 1
+
+  typedef struct RemoteStats
+  {
+    uint32_t frame;
+    size_t clientCount;
+    size_t tileCount;
+    size_t changedTileCount;
+    size_t encodedBytes;
+    size_t sentBytes;
+    float diffMilliseconds;
+    float encodeMilliseconds;
+  } RemoteStats;
+
+  // Streams frames drawn by GUI::Software to viewers on a Unix or TCP socket and feeds their mouse and keys back.
+  // Only tiles that changed since a viewer's last frame are compressed and sent, so bandwidth follows what changed and not the resolution.
+  // Addresses are "unix:<path>" or "[host:]port", a bare port only listens on the loopback interface.
+  // Poll runs after FocusManager::BeginFrame and sets the mouse in place of raylib's, SendFrame takes the finished R8G8B8A8 frame.
+  // The FocusManager given to Poll is kept to release a viewer's keys when it goes away, so it has to outlive the server.
+  class RemoteServer
+  {
+  public:
+    RemoteServer(void);
+    RemoteServer(int tileSize);
+    ~RemoteServer(void);
+
+    RemoteServer(const RemoteServer&) = delete;
+    RemoteServer& operator=(const RemoteServer&) = delete;
+
+    bool Listen(const char* address) noexcept;
+    void Close(void) noexcept;
+    void Poll(GUI::MouseState& mouseState, GUI::FocusManager* focus) noexcept;
+    void SendFrame(const Image& image);
+    size_t GetClientCount(void) const noexcept;
+    const GUI::RemoteStats& GetStats(void) const noexcept;
+
+  private:
+    struct Client
+    {
+      int socket;
+      std::string input;
+      std::string output;
+      size_t outputOffset;
+      std::vector<uint8_t> dirty;
+      std::vector<int> keysDown;
+    };
+
+    int m_Socket;
+    std::string m_Path;
+    int m_TileSize;
+    int m_Width;
+    int m_Height;
+    int m_Columns;
+    int m_Rows;
+    std::vector<uint32_t> m_Previous;
+    std::vector<uint8_t> m_Changed;
+    std::vector<std::string> m_Tiles;
+    std::vector<uint32_t> m_TileFrames;
+    std::vector<Client> m_Clients;
+    GUI::FocusManager* m_Focus;
+    Vector2 m_MousePosition;
+    bool m_MousePressed;
+    bool m_MouseDown;
+    GUI::RemoteStats m_Stats;
+
+  private:
+    void Accept(void) noexcept;
+    bool Read(Client& client) noexcept;
+    bool Flush(Client& client) noexcept;
+    void Disconnect(size_t index) noexcept;
+    const std::string& EncodeTile(size_t tile);
+  };
+
+  // The viewer side of a GUI::RemoteServer, keeps an image in sync with the server's frames and sends input back
+  class RemoteClient
+  {
+  public:
+    RemoteClient(void);
+    ~RemoteClient(void);
+
+    RemoteClient(const RemoteClient&) = delete;
+    RemoteClient& operator=(const RemoteClient&) = delete;
+
+    bool Connect(const char* address) noexcept;
+    void Close(void) noexcept;
+    bool IsConnected(void) const noexcept;
+    bool Receive(Image& image);
+    void SendMouse(Vector2 position, bool down) noexcept;
+    void SendKey(int key, bool down) noexcept;
+    void SendChar(int codepoint) noexcept;
+    size_t GetReceivedBytes(void) const noexcept;
+
+  private:
+    int m_Socket;
+    bool m_Greeted;
+    std::string m_Input;
+    std::string m_Output;
+    size_t m_ReceivedBytes;
+
+  private:
+    void Send(GUI::RemoteMessageTypes type, const void* payload, uint32_t size) noexcept;
+    bool Flush(void) noexcept;
+    bool ApplyFrame(Image& image, const unsigned char* data, size_t size);
+  };
+
+  typedef uint32_t WidgetId;
+
+  // Everything an immediate-mode widget keeps between frames, packed so the table stays dense
+  typedef struct WidgetState
+  {
+    GUI::WidgetId id;
+    uint32_t lastFrame;
+    float hoverProgress;
+    float activeProgress;
+    uint32_t cursor;
+    uint32_t anchor;
+    float scroll;
+  } WidgetState;
+
+  // Open addressing with linear probing, id 0 marks an empty slot
+  class WidgetTable
+  {
+  public:
+    WidgetTable(void);
+
+    GUI::WidgetState& Touch(GUI::WidgetId id, uint32_t frame) noexcept;
+    GUI::WidgetState* Find(GUI::WidgetId id) noexcept;
+    void Collect(uint32_t frame) noexcept;
+    size_t GetSize(void) const noexcept;
+    size_t GetCapacity(void) const noexcept;
+
+  private:
+    std::vector<GUI::WidgetState> m_Slots;
+    size_t m_Count;
+
+  private:
+    void Grow(void) noexcept;
+  };
+
+  // Per-frame state of the immediate-mode API, widget state not touched during a frame is dropped at EndFrame
+  class ImContext
+  {
+  public:
+    ImContext(void);
+
+    void BeginFrame(GUI::MouseState& mouseState) noexcept;
+    void EndFrame(void) noexcept;
+    void PushId(const char* id) noexcept;
+    void PushId(size_t index) noexcept;
+    void PopId(void) noexcept;
+    GUI::WidgetId GetId(const char* id) const noexcept;
+    GUI::WidgetState& GetState(GUI::WidgetId id) noexcept;
+    GUI::MouseState& GetMouseState(void) noexcept;
+    float Transition(float& progress, float target, float transitionTime) noexcept;
+    bool IsKeyRepeated(int key) noexcept;
+    bool IsKeyPressed(int key) const noexcept;
+    bool IsKeyDown(int key) const noexcept;
+    bool IsAnimating(void) const noexcept;
+    GUI::WidgetId GetFocused(void) const noexcept;
+    void SetFocused(GUI::WidgetId id) noexcept;
+
+  private:
+    GUI::WidgetTable m_Table;
+    GUI::MouseState* m_MouseState;
+    uint32_t m_Frame;
+    float m_FrameTime;
+    GUI::WidgetId m_IdStack[16];
+    size_t m_IdDepth;
+    GUI::WidgetId m_Focused;
+    int m_HeldKey;
+    float m_HeldTime;
+    float m_RepeatTime;
+    bool m_Animating;
+  };
+
+  // Immediate-mode widgets, the caller owns the data and the ImContext owns the state in between frames
+  namespace Im
+  {
+    bool Button(GUI::ImContext& context, const char* id, Rectangle bounds, const GUI::ButtonStyle& style, const char* text) noexcept;
+    // Typing and pasting stop at the same limits as GUI::Input::SetMaxLength, placeholderText may be nullptr
+    bool Input(GUI::ImContext& context, const char* id, Rectangle bounds, const GUI::InputStyle& style, std::string& text, const char* placeholderText, size_t maxCodepoints = SIZE_MAX, size_t maxBytes = GUI::INPUT_MAX_BYTES) noexcept;
+  }
+
+  // Font atlases baked at build time by tools/fontbake, alpha-only atlases follow the glyph tables
+  typedef struct FontBlobHeader
+  {
+    char     magic[4];
+    uint32_t version;
+    uint32_t fontCount;
+    uint32_t reserved;
+  } FontBlobHeader;
+
+  typedef struct FontBlobEntry
+  {
+    uint32_t name;
+    int32_t  baseSize;
+    int32_t  glyphCount;
+    int32_t  glyphPadding;
+    int32_t  atlasWidth;
+    int32_t  atlasHeight;
+    uint32_t glyphOffset;
+    uint32_t atlasOffset;
+  } FontBlobEntry;
+
+  typedef struct FontBlobGlyph
+  {
+    int32_t   value;
+    int32_t   offsetX;
+    int32_t   offsetY;
+    int32_t   advanceX;
+    Rectangle rec;
+  } FontBlobGlyph;
+
+  #define FONT_BLOB_VERSION 1
+
+  // Takes the nearest baked size within a quarter of fontSize when the exact one is missing, the font keeps that baseSize
+  bool LoadBakedFont(const unsigned char* blob, size_t size, const char* fileName, int fontSize, Font& font) noexcept;
+
+#ifdef GUI_BAKED_FONTS
+  extern const unsigned char bakedFonts[];
+  extern const size_t bakedFontsSize;
+#endif
+
+  enum LayoutWidgetTypes : uint8_t
+  {
+    LAYOUT_WIDGET_PANEL = 0,
+    LAYOUT_WIDGET_LABEL,
+    LAYOUT_WIDGET_BUTTON,
+    LAYOUT_WIDGET_INPUT,
+  };
+
+  // On-disk records of a compiled layout, little-endian and 4-byte aligned so they are used straight from the mapping
+  typedef struct LayoutHeader
+  {
+    char     magic[4];
+    uint32_t version;
+    uint32_t widgetCount;
+    uint32_t widgetOffset;
+    uint32_t styleCount;
+    uint32_t styleOffset;
+    uint32_t lookupCapacity;
+    uint32_t lookupOffset;
+    uint32_t stringOffset;
+    uint32_t stringSize;
+  } LayoutHeader;
+
+  typedef struct LayoutWidget
+  {
+    uint8_t   type;
+    uint8_t   reserved;
+    uint16_t  style;
+    uint32_t  parent;
+    uint32_t  next;
+    uint32_t  id;
+    uint32_t  text;
+    Rectangle bounds;
+  } LayoutWidget;
+
+  typedef struct LayoutLookup
+  {
+    uint32_t hash;
+    uint32_t widget;
+  } LayoutLookup;
+
+  #define LAYOUT_VERSION 1
+  #define LAYOUT_NO_PARENT UINT32_MAX
+
+  // A layout compiled by tools/guic, mapped read-only and never parsed into objects
+  class Layout
+  {
+  public:
+    Layout(void);
+    ~Layout(void);
+
+    Layout(const Layout&) = delete;
+    Layout& operator=(const Layout&) = delete;
+
+    bool Load(const char* fileName) noexcept;
+    void Unload(void) noexcept;
+    size_t GetWidgetCount(void) const noexcept;
+    const GUI::LayoutWidget* GetWidgets(void) const noexcept;
+    const GUI::LayoutWidget* Find(const char* id) const noexcept;
+    const char* GetString(uint32_t offset) const noexcept;
+    size_t GetStyleCount(void) const noexcept;
+    const char* GetStyleName(uint16_t style) const noexcept;
+
+  private:
+    const unsigned char* m_Data;
+    size_t m_Size;
+    bool m_Mapped;
+
+  private:
+    bool Validate(void) const noexcept;
+    const GUI::LayoutHeader& GetHeader(void) const noexcept;
+  };
+
+  // Selection, undo history and word boundaries, only allocated once an Input is focused or edited
+  typedef struct InputEditState
+  {
+    GUI::EditJournal journal;
+    GUI::WordIndex words;
+    std::string highlightText;
+    Vector2 highlightBounds;
+    size_t highlightStart;
+    size_t suggestionIndex;
+    double lastClickTime;
+    double lastKeyboardTime;
+    float timeWaited;
+    float keyWaited;
+    bool wordSelecting;
+  } InputEditState;
+
   class Input
   {
   public:
     Input(void);
     Input(Rectangle bounds, GUI::InputStyle style, const std::string& placeholderText);
+    ~Input(void);
 
     void UpdateAndRender(GUI::MouseState& mouseState) noexcept;
+    void SetBounds(Rectangle bounds) noexcept;
+    void SetStyle(const GUI::InputStyle& style);
     void SetPlaceholderText(const std::string& placeholderText) noexcept;
     void SetSelected(bool selected) noexcept;
+    void SetUndoLimit(size_t maxBytes) noexcept;
+    void SetMaxLength(size_t maxCodepoints, size_t maxBytes) noexcept;
+    bool Undo(void) noexcept;
+    bool Redo(void) noexcept;
+    void SetValidator(const GUI::Validator* validator) noexcept;
+    GUI::ValidationStates GetValidationState(void) const noexcept;
+    void SetAutocomplete(GUI::Autocomplete* autocomplete) noexcept;
+    void SetText(const std::string& text) noexcept;
+    const std::string& GetText(void) const noexcept;
+    const GUI::InputStyle& GetStyle(void) const noexcept;
+    void DrawToTiles(GUI::TileRenderer& tiles);
+    void ReportMemory(GUI::MemoryReport& report) const;
 
   private:
-    Rectangle m_Bounds;
-    GUI::InputStyle m_Style;
-    std::string m_PlaceholderText;
+    // Ordered by size so the hot layout packs without holes
     std::string m_InputText;
-    std::string m_HighlightText;
-    Vector2 m_HighlightBounds;
-    size_t m_HighlightStart;
+    std::unique_ptr<std::string> m_PlaceholderText;
+    std::unique_ptr<GUI::InputEditState> m_Edit;
+    std::vector<uint16_t> m_Checkpoints;
+    Rectangle m_Bounds;
     size_t m_CursorPosition;
+    size_t m_MaxCodepoints;
+    size_t m_MaxBytes;
+    size_t m_CodepointCount;
+    GUI::Animator* m_Animator;
+    const GUI::Validator* m_Validator;
+    GUI::Autocomplete* m_Autocomplete;
+    GUI::FocusManager* m_FocusManager;
+    float m_HoverProgress;
+    float m_SelectProgress;
     int m_XOffset;
+    GUI::StyleHandle m_Style;
+    uint16_t m_ValidatorState;
     bool m_Selected;
-    float m_TimeWaited;
-    float m_KeyWaited;
+    bool m_Hovered;
+    uint8_t m_PendingEvents;
 
   private:
-    void DrawCursor(void) noexcept;
+    GUI::InputEditState& Edit(void);
+    void DrawCursor(GUI::TileRenderer* tiles) noexcept;
     void UpdateCursorPosition(GUI::MouseState& mouseState) noexcept;
-    void ReplaceAll(std::string& str, const char toReplace, const char replaceWith) noexcept;
-    size_t FindLeftOf(const std::string& str, const char toFind, size_t startIndex) noexcept;
-    size_t FindRightOf(const std::string& str, const char toFind, size_t startIndex) noexcept;
+    void UpdateTransition(GUI::MouseState& mouseState, float& progress, float target) noexcept;
+    bool InsertText(const char* text, size_t length, bool coalesce) noexcept;
+    void Paste(const char* text) noexcept;
+    void EraseText(size_t offset, size_t length) noexcept;
+    void SelectWordAt(size_t index) noexcept;
+    void ClearHighlight(void) noexcept;
+    float MeasureRange(size_t start, size_t length) const noexcept;
+    uint16_t ValidatorStateAt(size_t offset) noexcept;
+    void Revalidate(size_t offset) noexcept;
+    void RequestSuggestions(void) noexcept;
+    void AcceptSuggestion(const std::string& suggestion) noexcept;
+    void DrawSuggestions(GUI::MouseState& mouseState) noexcept;
+    bool HandleKeyboard(void) noexcept;
+    void HandleKey(int key, bool typeCharacters) noexcept;
+    void OnTextChanged(void) noexcept;
+    void PushEvents(GUI::MouseState& mouseState);
+  };
+
+  // A screen of buttons and inputs rendered offscreen on the CPU in their resting state, for docs and visual diffs without a window.
+  // Each snapshot owns its widgets, tiles and image, so independent snapshots can be built and rendered on separate threads.
+  // Render can also split one large snapshot's tiles over a pool, as long as it is not called from a job on that pool.
+  class Snapshot
+  {
+  public:
+    Snapshot(int width, int height, Color backgroundColor);
+    ~Snapshot(void);
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    void AddFont(const Font& font, const Image& atlas);
+    GUI::Button& AddButton(Rectangle bounds, const GUI::ButtonStyle& style, const std::string& text);
+    GUI::Input& AddInput(Rectangle bounds, const GUI::InputStyle& style, const std::string& placeholderText, const std::string& text = "");
+    const Image& Render(GUI::ThreadPool* pool = nullptr);
+    bool Export(const char* fileName) const noexcept;
+
+  private:
+    struct Widget
+    {
+      GUI::LayoutWidgetTypes type;
+      size_t index;
+    };
+
+    Image m_Image;
+    Color m_BackgroundColor;
+    GUI::TileRenderer m_Tiles;
+    std::vector<Widget> m_Widgets;
+    std::deque<GUI::Button> m_Buttons;
+    std::deque<GUI::Input> m_Inputs;
   };
+
+  template <const GUI::StaticButtonStyle& Style, const Rectangle* Bounds>
+  StaticButton<Style, Bounds>::StaticButton(Font font, const std::string& text, Rectangle bounds)
+    : m_Font(font), m_Text(text), m_Bounds(bounds), m_Animator(nullptr), m_HoverProgress(0)
+  {
+    if constexpr (Bounds != nullptr)
+      m_Bounds = *Bounds;
+
+    UpdateTextPosition();
+  }
+
+  template <const GUI::StaticButtonStyle& Style, const Rectangle* Bounds>
+  StaticButton<Style, Bounds>::~StaticButton(void)
+  {
+    if (m_Animator)
+      m_Animator->Cancel(&m_HoverProgress);
+  }
+
+  template <const GUI::StaticButtonStyle& Style, const Rectangle* Bounds>
+  void StaticButton<Style, Bounds>::SetText(const std::string& text)
+  {
+    m_Text = text;
+    UpdateTextPosition();
+  }
+
+  template <const GUI::StaticButtonStyle& Style, const Rectangle* Bounds>
+  void StaticButton<Style, Bounds>::SetBounds(Rectangle bounds) noexcept
+  {
+    static_assert(Bounds == nullptr, "StaticButton bounds are fixed at compile time");
+    m_Bounds = bounds;
+    UpdateTextPosition();
+  }
+
+  template <const GUI::StaticButtonStyle& Style, const Rectangle* Bounds>
+  void StaticButton<Style, Bounds>::SetFont(Font font) noexcept
+  {
+    m_Font = font;
+    UpdateTextPosition();
+  }
+
+  template <const GUI::StaticButtonStyle& Style, const Rectangle* Bounds>
+  constexpr Rectangle StaticButton<Style, Bounds>::Expand(Rectangle bounds, float distance) noexcept
+  {
+    return { bounds.x-distance, bounds.y-distance, bounds.width+distance*2, bounds.height+distance*2 };
+  }
+
+  template <const GUI::StaticButtonStyle& Style, const Rectangle* Bounds>
+  constexpr Rectangle StaticButton<Style, Bounds>::ScaleBounds(Rectangle bounds, float progress) noexcept
+  {
+    float scaleX = (((bounds.width*Style.hoverScale)-bounds.width)/2)*progress;
+    float scaleY = (((bounds.height*Style.hoverScale)-bounds.height)/2)*progress;
+    return { bounds.x-scaleX/2, bounds.y-scaleY/2, bounds.width+scaleX, bounds.height+scaleY };
+  }
+
+  template <const GUI::StaticButtonStyle& Style, const Rectangle* Bounds>
+  void StaticButton<Style, Bounds>::UpdateTextPosition(void) noexcept
+  {
+    // The label never moves with the hover scale, so it is placed once per text or bounds change
+    m_TextPosition = { m_Bounds.x+5, m_Bounds.y+(m_Bounds.height/2)-(Style.fontSize/2) };
+
+    if constexpr (Style.textAlignment == TEXT_ALIGNMENT_CENTER)
+      m_TextPosition.x = m_Bounds.x+(m_Bounds.width/2)-(GUI::Text::MeasureRange(m_Font, m_Text.c_str(), m_Text.length(), Style.fontSize, SPACING)/2);
+    else if constexpr (Style.textAlignment == TEXT_ALIGNMENT_RIGHT)
+      m_TextPosition.x = m_Bounds.x+m_Bounds.width-5-GUI::Text::MeasureRange(m_Font, m_Text.c_str(), m_Text.length(), Style.fontSize, SPACING);
+  }
+
+  template <const GUI::StaticButtonStyle& Style, const Rectangle* Bounds>
+  void StaticButton<Style, Bounds>::Draw(Rectangle bounds, float outlineDistance, Color backgroundColor, Color outlineColor) noexcept
+  {
+    backgroundColor = GUI::ResolveColor(backgroundColor);
+    outlineColor = GUI::ResolveColor(outlineColor);
+
+    if constexpr (Style.outlineFill)
+    {
+      if constexpr (Style.roundness > 0)
+        DrawRectangleRounded(Expand(bounds, outlineDistance), Style.roundness, SEGMENTS, outlineColor);
+      else
+        DrawRectangleRec(Expand(bounds, outlineDistance), outlineColor);
+    }
+    else if constexpr (Style.outlineThickness > 0)
+    {
+      if constexpr (Style.roundness > 0)
+        DrawRectangleRoundedLines(Expand(bounds, outlineDistance), Style.roundness, SEGMENTS, Style.outlineThickness, outlineColor);
+      else
+        DrawRectangleLinesEx(Expand(bounds, outlineDistance+Style.outlineThickness), Style.outlineThickness, outlineColor);
+    }
+
+    if constexpr (Style.roundness > 0)
+      DrawRectangleRounded(bounds, Style.roundness, SEGMENTS, backgroundColor);
+    else
+      DrawRectangleRec(bounds, backgroundColor);
+  }
+
+  template <const GUI::StaticButtonStyle& Style, const Rectangle* Bounds>
+  void StaticButton<Style, Bounds>::DrawLabel(GUI::MouseState& mouseState, Color textColor) const
+  {
+    textColor = GUI::ResolveColor(textColor);
+    if (mouseState.textBatcher)
+      mouseState.textBatcher->AddText(m_Font, m_Text.c_str(), m_TextPosition, Style.fontSize, SPACING, textColor);
+    else
+      DrawTextEx(m_Font, m_Text.c_str(), m_TextPosition, Style.fontSize, SPACING, textColor);
+  }
+
+  template <const GUI::StaticButtonStyle& Style, const Rectangle* Bounds>
+  bool StaticButton<Style, Bounds>::UpdateAndRender(GUI::MouseState& mouseState) noexcept
+  {
+    bool clicked = false;
+    bool hovered = CheckCollisionPointRec(mouseState.position, m_Bounds);
+
+    if (hovered)
+    {
+      mouseState.cursor = MOUSE_CURSOR_POINTING_HAND;
+
+      if (!mouseState.clicked && mouseState.pressed)
+      {
+        clicked = true;
+        mouseState.clicked = true;
+      }
+    }
+
+    if constexpr (Style.transitionTime > 0)
+    {
+      float target = hovered ? 1.0f : 0.0f;
+      if (m_HoverProgress != target)
+      {
+        if (mouseState.animator)
+        {
+          m_Animator = mouseState.animator;
+          m_Animator->Animate(&m_HoverProgress, target, Style.transitionTime*(target > m_HoverProgress ? target-m_HoverProgress : m_HoverProgress-target));
+        }
+        else
+        {
+          m_HoverProgress = target;
+        }
+      }
+
+      // Only frames in the middle of a transition interpolate
+      if (m_HoverProgress > 0 && m_HoverProgress < 1)
+      {
+        float progress = m_HoverProgress;
+        Draw(ScaleBounds(m_Bounds, progress), Style.outlineDistance+Style.hoverOutlineOffset*progress, GUI::LerpColor(Style.baseBackgroundColor, Style.hoverBackgroundColor, progress), GUI::LerpColor(Style.baseOutlineColor, Style.hoverOutlineColor, progress));
+        DrawLabel(mouseState, GUI::LerpColor(Style.baseTextColor, Style.hoverTextColor, progress));
+        return clicked;
+      }
+
+      hovered = m_HoverProgress == 1;
+    }
+
+    if constexpr (Bounds != nullptr)
+    {
+      constexpr Rectangle hoverBounds = ScaleBounds(*Bounds, 1);
+
+      if (hovered)
+        Draw(hoverBounds, Style.outlineDistance+Style.hoverOutlineOffset, Style.hoverBackgroundColor, Style.hoverOutlineColor);
+      else
+        Draw(*Bounds, Style.outlineDistance, Style.baseBackgroundColor, Style.baseOutlineColor);
+    }
+    else
+    {
+      if (hovered)
+        Draw(ScaleBounds(m_Bounds, 1), Style.outlineDistance+Style.hoverOutlineOffset, Style.hoverBackgroundColor, Style.hoverOutlineColor);
+      else
+        Draw(m_Bounds, Style.outlineDistance, Style.baseBackgroundColor, Style.baseOutlineColor);
+    }
+
+    DrawLabel(mouseState, hovered ? Style.hoverTextColor : Style.baseTextColor);
+    return clicked;
+  }
 }
@@ -0,0 +1,110 @@
+#include "../../include/gui.hpp"
+
+#include <math.h>
+
+GUI::Animator::Animator(void)
+  : m_FrameRequested(false)
+{ }
+
+void GUI::Animator::Animate(float* target, float to, float duration) noexcept
+{
+  for (GUI::Tween& tween : m_Tweens)
+  {
+    if (tween.target != target)
+      continue;
+
+    if (tween.to == to)
+      return;
+
+    // Retarget from wherever the value is now
+    if (duration <= 0)
+    {
+      *target = to;
+      Cancel(target);
+      return;
+    }
+
+    tween.duration = duration;
+    tween.from = *target;
+    tween.to = to;
+    tween.elapsed = 0;
+    return;
+  }
+
+  if (duration <= 0 || *target == to)
+  {
+    *target = to;
+    return;
+  }
+
+  m_Tweens.push_back({ target, *target, to, 0, duration });
+}
+
+void GUI::Animator::Cancel(const float* target) noexcept
+{
+  for (size_t i = 0; i < m_Tweens.size(); i++)
+  {
+    if (m_Tweens[i].target == target)
+    {
+      m_Tweens[i] = m_Tweens.back();
+      m_Tweens.pop_back();
+      return;
+    }
+  }
+}
+
+void GUI::Animator::Update(float deltaTime) noexcept
+{
+  m_FrameRequested = false;
+
+  // The frame that starts a tween may follow a long idle wait, clamp so transitions never skip
+  if (deltaTime > 1.0f/30)
+    deltaTime = 1.0f/30;
+
+  for (size_t i = 0; i < m_Tweens.size();)
+  {
+    GUI::Tween& tween = m_Tweens[i];
+    tween.elapsed += deltaTime;
+
+    if (tween.elapsed >= tween.duration)
+    {
+      *tween.target = tween.to;
+      tween = m_Tweens.back();
+      m_Tweens.pop_back();
+      continue;
+    }
+
+    float t = tween.elapsed/tween.duration;
+    *tween.target = tween.from+(tween.to-tween.from)*(t*t*(3-2*t));
+    i++;
+  }
+}
+
+bool GUI::Animator::IsAnimating(void) const noexcept
+{
+  return !m_Tweens.empty();
+}
+
+float GUI::Animator::GetNextWakeup(void) const noexcept
+{
+  return m_Tweens.empty() && !m_FrameRequested ? INFINITY : 0;
+}
+
+void GUI::Animator::RequestFrame(void) noexcept
+{
+  m_FrameRequested = true;
+}
+
+Color GUI::LerpColor(Color from, Color to, float amount) noexcept
+{
+  // Every widget blends its style colors through here, which makes it the one place palette slots are resolved
+  from = GUI::ResolveColor(from);
+  to = GUI::ResolveColor(to);
+
+  return {
+    (unsigned char)(from.r+(to.r-from.r)*amount),
+    (unsigned char)(from.g+(to.g-from.g)*amount),
+    (unsigned char)(from.b+(to.b-from.b)*amount),
+    (unsigned char)(from.a+(to.a-from.a)*amount),
+  };
+}
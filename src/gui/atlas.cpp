@@ -0,0 +1,323 @@
+#include "../../include/gui.hpp"
+
+#include <string.h>
+
+#include <algorithm>
+
+static uint32_t HandleSlot(GUI::IconHandle icon) noexcept
+{
+  return (icon & 0xffff)-1;
+}
+
+static uint16_t HandleGeneration(GUI::IconHandle icon) noexcept
+{
+  return icon >> 16;
+}
+
+GUI::AtlasPacker::AtlasPacker(void)
+  : AtlasPacker(1024, 1024, 1)
+{ }
+
+GUI::AtlasPacker::AtlasPacker(int width, int height, int padding)
+  : m_Width(width), m_Height(height), m_Padding(padding > 0 ? padding : 0), m_Image(), m_Texture(), m_TextureDirty(false), m_Count(0), m_FreedArea(0), m_RepackCount(0)
+{
+  m_Skyline.push_back({ 0, 0, m_Width });
+}
+
+GUI::AtlasPacker::~AtlasPacker(void)
+{
+  if (m_Image.data)
+    UnloadImage(m_Image);
+
+  // The GPU texture is already gone when the atlas outlives the window
+  if (m_Texture.id && IsWindowReady())
+    UnloadTexture(m_Texture);
+}
+
+bool GUI::AtlasPacker::Place(std::vector<SkylineNode>& skyline, int width, int height, int& x, int& y) const
+{
+  // Bottom-left: the lowest top edge wins, the narrower node breaks ties so wide gaps stay open
+  size_t best = SIZE_MAX;
+  int bestTop = INT32_MAX;
+  int bestWidth = INT32_MAX;
+
+  for (size_t i = 0; i < skyline.size(); i++)
+  {
+    if (skyline[i].x+width > m_Width)
+      break;
+
+    // The rectangle rests on the highest node it spans
+    int top = 0;
+    int remaining = width;
+    for (size_t j = i; remaining > 0; j++)
+    {
+      if (skyline[j].y > top)
+        top = skyline[j].y;
+      remaining -= skyline[j].width;
+    }
+
+    if (top+height > m_Height)
+      continue;
+
+    if (top+height < bestTop || (top+height == bestTop && skyline[i].width < bestWidth))
+    {
+      best = i;
+      bestTop = top+height;
+      bestWidth = skyline[i].width;
+    }
+  }
+
+  if (best == SIZE_MAX)
+    return false;
+
+  x = skyline[best].x;
+  y = bestTop-height;
+
+  // The new node covers the rectangle's width, the nodes it shadows are cut or dropped
+  skyline.insert(skyline.begin()+best, { x, bestTop, width });
+  for (size_t i = best+1; i < skyline.size();)
+  {
+    int shadow = skyline[i-1].x+skyline[i-1].width-skyline[i].x;
+    if (shadow <= 0)
+      break;
+
+    if (shadow < skyline[i].width)
+    {
+      skyline[i].x += shadow;
+      skyline[i].width -= shadow;
+      break;
+    }
+
+    skyline.erase(skyline.begin()+i);
+  }
+
+  for (size_t i = 0; i+1 < skyline.size();)
+  {
+    if (skyline[i].y == skyline[i+1].y)
+    {
+      skyline[i].width += skyline[i+1].width;
+      skyline.erase(skyline.begin()+i+1);
+    }
+    else
+    {
+      i++;
+    }
+  }
+
+  return true;
+}
+
+void GUI::AtlasPacker::Blit(const unsigned char* pixels, int stride, int sourceX, int sourceY, int width, int height, int x, int y) noexcept
+{
+  // Copies the image to x+padding, y+padding and extrudes its edge pixels into the padding around it
+  unsigned char* target = (unsigned char*)m_Image.data;
+  int padding = m_Padding;
+  for (int row = 0; row < height; row++)
+  {
+    const unsigned char* source = pixels+((size_t)(sourceY+row)*stride+sourceX)*4;
+    unsigned char* line = target+((size_t)(y+padding+row)*m_Width+x)*4;
+    memcpy(line+padding*4, source, (size_t)width*4);
+    for (int i = 0; i < padding; i++)
+    {
+      memcpy(line+i*4, source, 4);
+      memcpy(line+(padding+width+i)*4, source+(width-1)*4, 4);
+    }
+  }
+
+  size_t lineBytes = (size_t)(width+padding*2)*4;
+  for (int i = 0; i < padding; i++)
+  {
+    memcpy(target+((size_t)(y+i)*m_Width+x)*4, target+((size_t)(y+padding)*m_Width+x)*4, lineBytes);
+    memcpy(target+((size_t)(y+padding+height+i)*m_Width+x)*4, target+((size_t)(y+padding+height-1)*m_Width+x)*4, lineBytes);
+  }
+
+  m_TextureDirty = true;
+}
+
+GUI::IconHandle GUI::AtlasPacker::Add(const Image& image)
+{
+  if (!image.data || image.width <= 0 || image.height <= 0)
+    return 0;
+
+  int width = image.width+m_Padding*2;
+  int height = image.height+m_Padding*2;
+  if (width > m_Width || height > m_Height)
+  {
+    TraceLog(LOG_WARNING, "GUI: %dx%d image does not fit a %dx%d atlas", image.width, image.height, m_Width, m_Height);
+    return 0;
+  }
+
+  size_t slot = 0;
+  while (slot < m_Entries.size() && m_Entries[slot].used)
+    slot++;
+  if (slot > UINT16_MAX-1)
+  {
+    TraceLog(LOG_WARNING, "GUI: More than %d images in an atlas", UINT16_MAX-1);
+    return 0;
+  }
+
+  int x, y;
+  if (!Place(m_Skyline, width, height, x, y))
+  {
+    // Holes left by removed images are only worth a repack when the image would fit in them
+    if (m_FreedArea < (size_t)width*height || !Repack() || !Place(m_Skyline, width, height, x, y))
+    {
+      TraceLog(LOG_WARNING, "GUI: Atlas is full, cannot add a %dx%d image", image.width, image.height);
+      return 0;
+    }
+  }
+
+  if (!m_Image.data)
+    m_Image = GenImageColor(m_Width, m_Height, BLANK);
+
+  // Any format raylib can convert is accepted, the atlas itself is always R8G8B8A8
+  if (image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+  {
+    Blit((const unsigned char*)image.data, image.width, 0, 0, image.width, image.height, x, y);
+  }
+  else
+  {
+    Image converted = ImageCopy(image);
+    ImageFormat(&converted, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    Blit((const unsigned char*)converted.data, converted.width, 0, 0, converted.width, converted.height, x, y);
+    UnloadImage(converted);
+  }
+
+  if (slot == m_Entries.size())
+    m_Entries.push_back({ Rectangle(), 0, false });
+
+  Entry& entry = m_Entries[slot];
+  entry.region = { (float)(x+m_Padding), (float)(y+m_Padding), (float)image.width, (float)image.height };
+  entry.generation++;
+  entry.used = true;
+  m_Count++;
+
+  return ((GUI::IconHandle)entry.generation << 16) | (GUI::IconHandle)(slot+1);
+}
+
+GUI::IconHandle GUI::AtlasPacker::Load(const char* fileName)
+{
+  Image image = LoadImage(fileName);
+  if (!image.data)
+    return 0;
+
+  GUI::IconHandle icon = Add(image);
+  UnloadImage(image);
+  return icon;
+}
+
+void GUI::AtlasPacker::Remove(GUI::IconHandle icon) noexcept
+{
+  uint32_t slot = HandleSlot(icon);
+  if (!icon || slot >= m_Entries.size() || !m_Entries[slot].used || m_Entries[slot].generation != HandleGeneration(icon))
+    return;
+
+  // The pixels stay until a repack, nothing draws from them anymore
+  Entry& entry = m_Entries[slot];
+  entry.used = false;
+  m_FreedArea += (size_t)(entry.region.width+m_Padding*2)*(entry.region.height+m_Padding*2);
+  m_Count--;
+}
+
+bool GUI::AtlasPacker::Repack(void)
+{
+  // Tallest first packs a skyline tightest, everything is placed before any pixel moves so a failure changes nothing
+  std::vector<uint32_t> order;
+  for (uint32_t i = 0; i < m_Entries.size(); i++)
+  {
+    if (m_Entries[i].used)
+      order.push_back(i);
+  }
+
+  std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+  {
+    const Rectangle& first = m_Entries[a].region;
+    const Rectangle& second = m_Entries[b].region;
+    return first.height != second.height ? first.height > second.height : first.width > second.width;
+  });
+
+  std::vector<SkylineNode> skyline = { { 0, 0, m_Width } };
+  std::vector<Rectangle> regions(m_Entries.size());
+  for (uint32_t index : order)
+  {
+    const Rectangle& region = m_Entries[index].region;
+    int x, y;
+    if (!Place(skyline, (int)region.width+m_Padding*2, (int)region.height+m_Padding*2, x, y))
+      return false;
+    regions[index] = { (float)(x+m_Padding), (float)(y+m_Padding), region.width, region.height };
+  }
+
+  if (m_Image.data)
+  {
+    std::vector<unsigned char> previous((const unsigned char*)m_Image.data, (const unsigned char*)m_Image.data+(size_t)m_Width*m_Height*4);
+    memset(m_Image.data, 0, previous.size());
+    for (uint32_t index : order)
+    {
+      const Rectangle& region = m_Entries[index].region;
+      Blit(previous.data(), m_Width, (int)region.x, (int)region.y, (int)region.width, (int)region.height, (int)regions[index].x-m_Padding, (int)regions[index].y-m_Padding);
+    }
+  }
+
+  for (uint32_t index : order)
+    m_Entries[index].region = regions[index];
+
+  m_Skyline.swap(skyline);
+  m_FreedArea = 0;
+  m_RepackCount++;
+  m_TextureDirty = true;
+  return true;
+}
+
+Rectangle GUI::AtlasPacker::GetRegion(GUI::IconHandle icon) const noexcept
+{
+  uint32_t slot = HandleSlot(icon);
+  if (!icon || slot >= m_Entries.size() || !m_Entries[slot].used || m_Entries[slot].generation != HandleGeneration(icon))
+    return Rectangle();
+
+  return m_Entries[slot].region;
+}
+
+Texture2D GUI::AtlasPacker::GetTexture(void) noexcept
+{
+  // Uploaded on first use so an atlas can be filled before InitWindow, later changes replace the whole texture once
+  if (!m_Image.data)
+    return m_Texture;
+
+  if (!m_Texture.id)
+  {
+    m_Texture = LoadTextureFromImage(m_Image);
+    SetTextureFilter(m_Texture, TEXTURE_FILTER_BILINEAR);
+    m_TextureDirty = false;
+  }
+  else if (m_TextureDirty)
+  {
+    UpdateTexture(m_Texture, m_Image.data);
+    m_TextureDirty = false;
+  }
+
+  return m_Texture;
+}
+
+const Image& GUI::AtlasPacker::GetImage(void) const noexcept
+{
+  return m_Image;
+}
+
+size_t GUI::AtlasPacker::GetCount(void) const noexcept
+{
+  return m_Count;
+}
+
+size_t GUI::AtlasPacker::GetRepackCount(void) const noexcept
+{
+  return m_RepackCount;
+}
+
+void GUI::AtlasPacker::ReportMemory(GUI::MemoryReport& report) const
+{
+  size_t bytes = sizeof(GUI::AtlasPacker)+m_Entries.capacity()*sizeof(Entry)+m_Skyline.capacity()*sizeof(SkylineNode);
+  if (m_Image.data)
+    bytes += (size_t)m_Width*m_Height*4;
+
+  report.Add("cache", "AtlasPacker", bytes, m_Count);
+}
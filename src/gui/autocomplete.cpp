@@ -0,0 +1,270 @@
+#include "../../include/gui.hpp"
+
+#include <algorithm>
+
+static inline unsigned char Fold(char c) noexcept
+{
+  return c >= 'A' && c <= 'Z' ? c+32 : (unsigned char)c;
+}
+
+// Zero when the entry starts with the prefix, ASCII case-insensitive
+static int ComparePrefix(const char* entry, size_t entryLength, const char* prefix, size_t length) noexcept
+{
+  for (size_t i = 0; i < length; i++)
+  {
+    if (i == entryLength)
+      return -1;
+
+    unsigned char a = Fold(entry[i]);
+    unsigned char b = Fold(prefix[i]);
+    if (a != b)
+      return a < b ? -1 : 1;
+  }
+
+  return 0;
+}
+
+void GUI::PrefixIndex::Build(const std::vector<std::string>& entries)
+{
+  // Sorting on the first eight folded bytes keeps most comparisons away from the strings themselves
+  std::vector<std::pair<uint64_t, uint32_t>> order(entries.size());
+  for (size_t i = 0; i < order.size(); i++)
+  {
+    uint64_t key = 0;
+    for (size_t j = 0; j < 8; j++)
+      key = (key << 8) | (j < entries[i].length() ? Fold(entries[i][j]) : 0);
+    order[i] = { key, (uint32_t)i };
+  }
+
+  std::sort(order.begin(), order.end(), [&entries](const std::pair<uint64_t, uint32_t>& a, const std::pair<uint64_t, uint32_t>& b)
+  {
+    if (a.first != b.first)
+      return a.first < b.first;
+
+    const std::string& left = entries[a.second];
+    const std::string& right = entries[b.second];
+    int compare = ComparePrefix(left.c_str(), left.length(), right.c_str(), right.length() < left.length() ? right.length() : left.length());
+    return compare ? compare < 0 : left.length() < right.length();
+  });
+
+  // One blob plus offsets, a few bytes of overhead per entry even for millions of symbols
+  size_t bytes = 0;
+  for (const std::string& entry : entries)
+    bytes += entry.length();
+
+  m_Data.clear();
+  m_Data.reserve(bytes);
+  m_Offsets.clear();
+  m_Offsets.reserve(entries.size()+1);
+
+  for (const std::pair<uint64_t, uint32_t>& entry : order)
+  {
+    m_Offsets.push_back(m_Data.size());
+    m_Data.append(entries[entry.second]);
+  }
+  m_Offsets.push_back(m_Data.size());
+}
+
+size_t GUI::PrefixIndex::GetSize(void) const noexcept
+{
+  return m_Offsets.empty() ? 0 : m_Offsets.size()-1;
+}
+
+std::string GUI::PrefixIndex::GetEntry(size_t index) const
+{
+  return m_Data.substr(m_Offsets[index], m_Offsets[index+1]-m_Offsets[index]);
+}
+
+void GUI::PrefixIndex::Find(const char* prefix, size_t length, size_t& first, size_t& last) const noexcept
+{
+  // Narrows [first, last) to the entries starting with prefix
+  size_t low = first;
+  size_t high = last;
+  while (low < high)
+  {
+    size_t middle = low+(high-low)/2;
+    if (ComparePrefix(m_Data.c_str()+m_Offsets[middle], m_Offsets[middle+1]-m_Offsets[middle], prefix, length) < 0)
+      low = middle+1;
+    else
+      high = middle;
+  }
+
+  first = low;
+  high = last;
+  while (low < high)
+  {
+    size_t middle = low+(high-low)/2;
+    if (ComparePrefix(m_Data.c_str()+m_Offsets[middle], m_Offsets[middle+1]-m_Offsets[middle], prefix, length) <= 0)
+      low = middle+1;
+    else
+      high = middle;
+  }
+
+  last = low;
+}
+
+GUI::Autocomplete::Autocomplete(void)
+  : Autocomplete(8)
+{ }
+
+GUI::Autocomplete::Autocomplete(size_t maxSuggestions)
+  : m_MaxSuggestions(maxSuggestions), m_Generation(0), m_QueryOwner(nullptr), m_QueryGeneration(0), m_HasQuery(false), m_HasEntries(false), m_Quit(false), m_ResultOwner(nullptr), m_ResultGeneration(0), m_HasResults(false), m_Owner(nullptr), m_PendingGeneration(0)
+{
+  m_Thread = std::thread(&GUI::Autocomplete::Run, this);
+}
+
+GUI::Autocomplete::~Autocomplete(void)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Quit = true;
+    m_Generation++;
+  }
+
+  m_Condition.notify_one();
+  m_Thread.join();
+}
+
+void GUI::Autocomplete::SetEntries(std::vector<std::string> entries) noexcept
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Entries.swap(entries);
+    m_HasEntries = true;
+    if (m_QueryOwner)
+      m_PendingGeneration = m_QueryGeneration;
+  }
+
+  m_Condition.notify_one();
+}
+
+void GUI::Autocomplete::Request(const void* owner, const std::string& prefix) noexcept
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Query = prefix;
+    m_QueryOwner = owner;
+    m_QueryGeneration = ++m_Generation;
+    m_HasQuery = true;
+  }
+
+  m_PendingGeneration = m_QueryGeneration;
+
+  m_Condition.notify_one();
+}
+
+void GUI::Autocomplete::Cancel(const void* owner) noexcept
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (m_QueryOwner == owner)
+  {
+    m_Generation++;
+    m_QueryOwner = nullptr;
+    m_HasQuery = false;
+    m_PendingGeneration = 0;
+  }
+
+  if (m_Owner == owner)
+  {
+    m_Suggestions.clear();
+    m_Owner = nullptr;
+  }
+}
+
+void GUI::Autocomplete::Update(void) noexcept
+{
+  // Never waits on the worker, results that are not ready yet show up on a later frame
+  std::unique_lock<std::mutex> lock(m_Mutex, std::try_to_lock);
+  if (!lock.owns_lock() || !m_HasResults)
+    return;
+
+  m_HasResults = false;
+  if (m_ResultGeneration != m_Generation)
+    return;
+
+  m_Suggestions.swap(m_Results);
+  m_Prefix.swap(m_ResultPrefix);
+  m_Owner = m_ResultOwner;
+  if (m_ResultGeneration == m_PendingGeneration)
+    m_PendingGeneration = 0;
+}
+
+bool GUI::Autocomplete::IsPending(void) const noexcept
+{
+  return m_PendingGeneration != 0;
+}
+
+const std::vector<std::string>& GUI::Autocomplete::GetSuggestions(const void* owner, const std::string& prefix) const noexcept
+{
+  static const std::vector<std::string> none;
+  return m_Owner == owner && m_Prefix == prefix ? m_Suggestions : none;
+}
+
+void GUI::Autocomplete::Run(void) noexcept
+{
+  GUI::PrefixIndex index;
+  std::string lastQuery;
+  size_t lastFirst = 0;
+  size_t lastLast = 0;
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  for (;;)
+  {
+    m_Condition.wait(lock, [this] { return m_Quit || m_HasQuery || m_HasEntries; });
+    if (m_Quit)
+      return;
+
+    if (m_HasEntries)
+    {
+      std::vector<std::string> entries;
+      entries.swap(m_Entries);
+      m_HasEntries = false;
+
+      lock.unlock();
+      index.Build(entries);
+      entries.clear();
+      lastQuery.clear();
+      lastFirst = 0;
+      lastLast = index.GetSize();
+      lock.lock();
+
+      // Whatever was typed while the index was building is looked up again
+      m_HasQuery = m_QueryOwner != nullptr;
+      continue;
+    }
+
+    std::string query = m_Query;
+    const void* owner = m_QueryOwner;
+    uint32_t generation = m_QueryGeneration;
+    m_HasQuery = false;
+    lock.unlock();
+
+    // Typing usually extends the last query, so the search starts from its range
+    size_t first = 0;
+    size_t last = index.GetSize();
+    if (!lastQuery.empty() && query.compare(0, lastQuery.length(), lastQuery) == 0)
+    {
+      first = lastFirst;
+      last = lastLast;
+    }
+    index.Find(query.c_str(), query.length(), first, last);
+
+    lastQuery = query;
+    lastFirst = first;
+    lastLast = last;
+
+    std::vector<std::string> results;
+    for (size_t i = first; i < last && results.size() < m_MaxSuggestions && generation == m_Generation; i++)
+      results.push_back(index.GetEntry(i));
+
+    lock.lock();
+    if (generation == m_Generation)
+    {
+      m_Results.swap(results);
+      m_ResultPrefix = query;
+      m_ResultOwner = owner;
+      m_ResultGeneration = generation;
+      m_HasResults = true;
+    }
+  }
+}
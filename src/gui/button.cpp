@@ -1,63 +1,305 @@
 #include "../../include/gui.hpp"
 
+#include <math.h>
+
+static bool UsesPalette(const GUI::ButtonStyle& style) noexcept
+{
+  return GUI::IsPaletteColor(style.baseBackgroundColor) || GUI::IsPaletteColor(style.baseTextColor) || GUI::IsPaletteColor(style.baseOutlineColor) || GUI::IsPaletteColor(style.hoverBackgroundColor) || GUI::IsPaletteColor(style.hoverTextColor) || GUI::IsPaletteColor(style.hoverOutlineColor);
+}
+
 GUI::Button::Button(Rectangle bounds, GUI::ButtonStyle style, const std::string& text)
-  : m_Bounds(bounds), m_Style(style), m_Text(text)
+  : m_Bounds(bounds), m_Style(style), m_Text(text), m_SurfaceCache(nullptr), m_Atlas(nullptr), m_Icon(0), m_Surfaces(), m_Animator(nullptr), m_HoverProgress(0), m_Hovered(false), m_UsesPalette(UsesPalette(style)), m_ThemeGeneration(GUI::GetThemeGeneration())
 { }
 
-GUI::Button::Button(void) { }
+GUI::Button::Button(void)
+  : m_SurfaceCache(nullptr), m_Atlas(nullptr), m_Icon(0), m_Surfaces(), m_Animator(nullptr), m_HoverProgress(0), m_Hovered(false), m_UsesPalette(false), m_ThemeGeneration(GUI::GetThemeGeneration())
+{ }
 
-bool GUI::Button::UpdateAndRender(GUI::MouseState& mouseState)
+GUI::Button::~Button(void)
 {
-  Rectangle newBounds = m_Bounds;
+  if (m_Animator)
+    m_Animator->Cancel(&m_HoverProgress);
+}
 
-  bool clicked = false;
+void GUI::Button::SetBounds(Rectangle bounds) noexcept
+{
+  m_Bounds = bounds;
+  InvalidateSurfaces();
+}
+
+void GUI::Button::SetStyle(const GUI::ButtonStyle& style) noexcept
+{
+  m_Style = style;
+  m_UsesPalette = UsesPalette(style);
+  InvalidateSurfaces();
+}
+
+void GUI::Button::SetText(const std::string& text) noexcept
+{
+  m_Text = text;
+  InvalidateSurfaces();
+}
+
+void GUI::Button::SetSurfaceCache(GUI::SurfaceCache* surfaceCache) noexcept
+{
+  m_SurfaceCache = surfaceCache;
+  m_Surfaces[0] = GUI::SurfaceSlot();
+  m_Surfaces[1] = GUI::SurfaceSlot();
+}
+
+void GUI::Button::SetIcon(GUI::AtlasPacker* atlas, GUI::IconHandle icon) noexcept
+{
+  m_Atlas = atlas;
+  m_Icon = icon;
+  InvalidateSurfaces();
+}
+
+const GUI::ButtonStyle& GUI::Button::GetStyle(void) const noexcept
+{
+  return m_Style;
+}
+
+void GUI::Button::InvalidateSurfaces(void) noexcept
+{
+  m_Surfaces[0].valid = false;
+  m_Surfaces[1].valid = false;
+}
+
+Vector2 GUI::Button::GetIconSize(void) const noexcept
+{
+  Rectangle region = m_Atlas ? m_Atlas->GetRegion(m_Icon) : Rectangle();
+  if (region.width <= 0 || region.height <= 0)
+    return { 0, 0 };
+
+  // Scaled to the icon height, keeping the image's aspect
+  float height = m_Style.iconSize > 0 ? m_Style.iconSize : m_Style.fontSize;
+  return { region.width*height/region.height, height };
+}
+
+Vector2 GUI::Button::GetTextPosition(Vector2 offset) const noexcept
+{
+  // The icon and the label are aligned as one group, with the icon on the left
+  Vector2 icon = GetIconSize();
+  float iconWidth = icon.x > 0 ? icon.x+(m_Text.empty() ? 0 : m_Style.iconSpacing) : 0;
+  Vector2 position = { m_Bounds.x+offset.x+5+iconWidth, m_Bounds.y+offset.y+(m_Bounds.height/2)-((float)m_Style.fontSize/2) };
+
+  switch (m_Style.textAlignment)
+  {
+    case TEXT_ALIGNMENT_CENTER:
+      position.x = m_Bounds.x+offset.x+(m_Bounds.width/2)-((iconWidth+GUI::Text::MeasureRange(m_Style.font, m_Text.c_str(), m_Text.length(), m_Style.fontSize, SPACING))/2)+iconWidth;
+      break;
+    case TEXT_ALIGNMENT_RIGHT:
+      position.x = m_Bounds.x+offset.x+m_Bounds.width-5-GUI::Text::MeasureRange(m_Style.font, m_Text.c_str(), m_Text.length(), m_Style.fontSize, SPACING);
+      break;
+  }
+
+  return position;
+}
+
+Rectangle GUI::Button::GetIconBounds(Vector2 textPosition) const noexcept
+{
+  Vector2 icon = GetIconSize();
+  float x = textPosition.x-icon.x-(m_Text.empty() ? 0 : m_Style.iconSpacing);
+  float y = textPosition.y+((float)m_Style.fontSize/2)-(icon.y/2);
+  return { x, y, icon.x, icon.y };
+}
+
+Rectangle GUI::Button::GetSurfaceArea(Rectangle bounds, float outlineDistance) const noexcept
+{
+  float outline = outlineDistance+(m_Style.outlineFill ? 0 : m_Style.outlineThickness)+1;
+  float left = bounds.x-outline;
+  float top = bounds.y-outline;
+  float right = bounds.x+bounds.width+outline;
+  float bottom = bounds.y+bounds.height+outline;
+
+  // Long labels and large icons can overflow the button
+  Vector2 textPosition = GetTextPosition({ 0, 0 });
+  float textWidth = GUI::Text::MeasureRange(m_Style.font, m_Text.c_str(), m_Text.length(), m_Style.fontSize, SPACING);
+  Rectangle icon = GetIconBounds(textPosition);
+  if (icon.width <= 0)
+    icon = { textPosition.x, textPosition.y, 0, 0 };
+
+  if (icon.x < left)
+    left = icon.x;
+  if (textPosition.x+textWidth > right)
+    right = textPosition.x+textWidth;
+  if (textPosition.y < top)
+    top = textPosition.y;
+  if (icon.y < top)
+    top = icon.y;
+  if (textPosition.y+m_Style.fontSize > bottom)
+    bottom = textPosition.y+m_Style.fontSize;
+  if (icon.y+icon.height > bottom)
+    bottom = icon.y+icon.height;
+
+  // Whole pixels so the fractional position is baked into the surface
+  left = floorf(left);
+  top = floorf(top);
+  return { left, top, ceilf(right)-left+1, ceilf(bottom)-top+1 };
+}
+
+void GUI::Button::Render(Rectangle bounds, Vector2 offset, float outlineDistance, Color backgroundColor, Color outlineColor, Color textColor, GUI::TextBatcher* textBatcher) noexcept
+{
+  Rectangle newBounds = { bounds.x+offset.x, bounds.y+offset.y, bounds.width, bounds.height };
+
+  if (m_Style.outlineFill)
+    DrawRectangleRounded({ newBounds.x-outlineDistance, newBounds.y-outlineDistance, newBounds.width+outlineDistance*2, newBounds.height+outlineDistance*2 }, m_Style.roundness, SEGMENTS, outlineColor);
+  else
+    DrawRectangleRoundedLines({ newBounds.x-outlineDistance, newBounds.y-outlineDistance, newBounds.width+outlineDistance*2, newBounds.height+outlineDistance*2 }, m_Style.roundness, SEGMENTS, m_Style.outlineThickness, outlineColor);
 
-  Color backgroundColor = m_Style.baseBackgroundColor;
-  Color outlineColor = m_Style.baseOutlineColor;
-  Color textColor = m_Style.baseTextColor;
+  DrawRectangleRounded(newBounds, m_Style.roundness, SEGMENTS, backgroundColor);
+
+  // Icons go through the batcher with the text, so a row of icon buttons costs one batch for all of its icons
+  Vector2 textPosition = GetTextPosition(offset);
+  Rectangle icon = GetIconBounds(textPosition);
+  if (icon.width > 0)
+  {
+    if (textBatcher)
+      textBatcher->AddQuad(m_Atlas->GetTexture(), m_Atlas->GetRegion(m_Icon), icon, WHITE);
+    else
+      DrawTexturePro(m_Atlas->GetTexture(), m_Atlas->GetRegion(m_Icon), icon, { 0, 0 }, 0, WHITE);
+  }
+
+  if (textBatcher)
+    textBatcher->AddText(m_Style.font, m_Text.c_str(), textPosition, m_Style.fontSize, SPACING, textColor);
+  else
+    DrawTextEx(m_Style.font, m_Text.c_str(), textPosition, m_Style.fontSize, SPACING, textColor);
+}
+
+void GUI::Button::RenderSoftware(GUI::TileRenderer& tiles, const Image& atlas, Rectangle bounds, Vector2 offset, float outlineDistance, Color backgroundColor, Color outlineColor, Color textColor)
+{
+  Rectangle newBounds = { bounds.x+offset.x, bounds.y+offset.y, bounds.width, bounds.height };
+  Rectangle outlineBounds = { newBounds.x-outlineDistance, newBounds.y-outlineDistance, newBounds.width+outlineDistance*2, newBounds.height+outlineDistance*2 };
+
+  if (m_Style.outlineFill)
+    tiles.DrawRectangleRounded(outlineBounds, m_Style.roundness, outlineColor);
+  else
+    tiles.DrawRectangleRoundedLines(outlineBounds, m_Style.roundness, m_Style.outlineThickness, outlineColor);
+
+  tiles.DrawRectangleRounded(newBounds, m_Style.roundness, backgroundColor);
+
+  Vector2 textPosition = GetTextPosition(offset);
+  Rectangle icon = GetIconBounds(textPosition);
+  if (icon.width > 0)
+    tiles.DrawImage(m_Atlas->GetImage(), m_Atlas->GetRegion(m_Icon), icon, WHITE);
+
+  tiles.DrawTextEx(atlas, m_Style.font, m_Text.c_str(), textPosition, m_Style.fontSize, SPACING, textColor);
+}
+
+void GUI::Button::DrawToTiles(GUI::TileRenderer& tiles)
+{
+  // The resting state, recorded for an image without a surface or a window
+  RenderSoftware(tiles, tiles.GetFontAtlas(m_Style.font), m_Bounds, { 0, 0 }, m_Style.outlineDistance, GUI::ResolveColor(m_Style.baseBackgroundColor), GUI::ResolveColor(m_Style.baseOutlineColor), GUI::ResolveColor(m_Style.baseTextColor));
+}
+
+bool GUI::Button::UpdateAndRender(GUI::MouseState& mouseState)
+{
+  bool clicked = false;
 
-  if (CheckCollisionPointRec(mouseState.position, m_Bounds))
+  bool hovered = CheckCollisionPointRec(mouseState.position, m_Bounds);
+  float target = hovered ? 1.0f : 0.0f;
+  if (m_HoverProgress != target)
   {
-    backgroundColor = m_Style.hoverBackgroundColor;
-    outlineColor = m_Style.hoverOutlineColor;
-    textColor = m_Style.hoverTextColor;
+    if (mouseState.animator && m_Style.transitionTime > 0)
+    {
+      m_Animator = mouseState.animator;
+      m_Animator->Animate(&m_HoverProgress, target, m_Style.transitionTime*fabsf(target-m_HoverProgress));
+    }
+    else
+    {
+      m_HoverProgress = target;
+    }
+  }
+
+  float progress = m_HoverProgress;
+  Color backgroundColor = GUI::LerpColor(m_Style.baseBackgroundColor, m_Style.hoverBackgroundColor, progress);
+  Color outlineColor = GUI::LerpColor(m_Style.baseOutlineColor, m_Style.hoverOutlineColor, progress);
+  Color textColor = GUI::LerpColor(m_Style.baseTextColor, m_Style.hoverTextColor, progress);
+  float outlineDistance = m_Style.outlineDistance+m_Style.hoverOutlineOffset*progress;
 
-    float scaleX = ((m_Bounds.width*m_Style.hoverScale)-m_Bounds.width)/2;
-    float scaleY = ((m_Bounds.height*m_Style.hoverScale)-m_Bounds.height)/2;
+  Rectangle newBounds = m_Bounds;
+  float scaleX = (((m_Bounds.width*m_Style.hoverScale)-m_Bounds.width)/2)*progress;
+  float scaleY = (((m_Bounds.height*m_Style.hoverScale)-m_Bounds.height)/2)*progress;
 
-    newBounds.x -= scaleX/2;
-    newBounds.y -= scaleY/2;
-    newBounds.width += scaleX;
-    newBounds.height += scaleY;
+  newBounds.x -= scaleX/2;
+  newBounds.y -= scaleY/2;
+  newBounds.width += scaleX;
+  newBounds.height += scaleY;
 
+  if (hovered)
+  {
     mouseState.cursor = MOUSE_CURSOR_POINTING_HAND;
 
-    if (!mouseState.clicked && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+    if (!mouseState.clicked && mouseState.pressed)
     {
       clicked = true;
       mouseState.clicked = true;
     }
   }
 
-  if (m_Style.outlineFill)
-    DrawRectangleRounded({ newBounds.x-m_Style.outlineDistance, newBounds.y-m_Style.outlineDistance, newBounds.width+m_Style.outlineDistance*2, newBounds.height+m_Style.outlineDistance*2 }, m_Style.roundness, SEGMENTS, outlineColor);
-  else
-    DrawRectangleRoundedLines({ newBounds.x-m_Style.outlineDistance, newBounds.y-m_Style.outlineDistance, newBounds.width+m_Style.outlineDistance*2, newBounds.height+m_Style.outlineDistance*2 }, m_Style.roundness, SEGMENTS, m_Style.outlineThickness, outlineColor);
+  if (mouseState.events)
+  {
+    if (hovered != m_Hovered)
+      mouseState.events->Push(hovered ? GUI::EVENT_HOVER_ENTER : GUI::EVENT_HOVER_LEAVE, this);
+    if (clicked)
+      mouseState.events->Push(GUI::EVENT_CLICK, this);
+  }
+  m_Hovered = hovered;
 
-  DrawRectangleRounded(newBounds, m_Style.roundness, SEGMENTS, backgroundColor);
+  // A software frame has no surfaces, every state is recorded like a transition frame
+  if (mouseState.tiles)
+  {
+    RenderSoftware(*mouseState.tiles, mouseState.tiles->GetFontAtlas(m_Style.font), newBounds, { 0, 0 }, outlineDistance, backgroundColor, outlineColor, textColor);
+    return clicked;
+  }
 
-  switch (m_Style.textAlignment)
+  // Only the resting states are cached, in-between frames of a transition draw directly
+  if (m_SurfaceCache && (progress == 0 || progress == 1))
   {
-    case TEXT_ALIGNMENT_LEFT:
-      DrawTextEx(m_Style.font, m_Text.c_str(), { m_Bounds.x+5, m_Bounds.y+(m_Bounds.height/2)-((float)m_Style.fontSize/2) }, m_Style.fontSize, SPACING, textColor);
-      break;
-    case TEXT_ALIGNMENT_CENTER:
-      DrawTextEx(m_Style.font, m_Text.c_str(), { m_Bounds.x+(m_Bounds.width/2)-(MeasureTextEx(m_Style.font, m_Text.c_str(), m_Style.fontSize, SPACING).x/2), m_Bounds.y+(m_Bounds.height/2)-((float)m_Style.fontSize/2) }, m_Style.fontSize, SPACING, textColor);
-      break;
-    case TEXT_ALIGNMENT_RIGHT:
-      DrawTextEx(m_Style.font, m_Text.c_str(), { m_Bounds.x+m_Bounds.width-5-MeasureTextEx(m_Style.font, m_Text.c_str(), m_Style.fontSize, SPACING).x, m_Bounds.y+(m_Bounds.height/2)-((float)m_Style.fontSize/2) }, m_Style.fontSize, SPACING, textColor);
-      break;
+    // Surfaces drawn with another theme are stale, buttons with fixed colors keep theirs
+    if (m_UsesPalette && m_ThemeGeneration != GUI::GetThemeGeneration())
+    {
+      InvalidateSurfaces();
+      m_ThemeGeneration = GUI::GetThemeGeneration();
+    }
+
+    GUI::SurfaceSlot& surface = m_Surfaces[progress == 1];
+    if (surface.valid && m_SurfaceCache->IsResident(surface))
+    {
+      m_SurfaceCache->DrawSurface(surface, mouseState.textBatcher);
+      return clicked;
+    }
+
+    Rectangle area = GetSurfaceArea(newBounds, outlineDistance);
+    if (m_SurfaceCache->Acquire(surface, area.width, area.height, mouseState.textBatcher))
+    {
+      Vector2 offset = { surface.region.x-area.x, surface.region.y-area.y };
+
+      m_SurfaceCache->BeginSurface(surface);
+      if (m_SurfaceCache->GetBackend() == SURFACE_BACKEND_CPU)
+        RenderSoftware(m_SurfaceCache->GetTiles(), m_SurfaceCache->GetFontAtlas(m_Style.font), newBounds, offset, outlineDistance, backgroundColor, outlineColor, textColor);
+      else
+        Render(newBounds, offset, outlineDistance, backgroundColor, outlineColor, textColor, nullptr);
+      m_SurfaceCache->EndSurface();
+
+      surface.origin = { area.x, area.y };
+      surface.valid = true;
+      m_SurfaceCache->DrawSurface(surface, mouseState.textBatcher);
+      return clicked;
+    }
   }
 
+  Render(newBounds, { 0, 0 }, outlineDistance, backgroundColor, outlineColor, textColor, mouseState.textBatcher);
+
   return clicked;
 }
+
+void GUI::Button::ReportMemory(GUI::MemoryReport& report) const
+{
+  // Capacity beyond the inline buffer is the string's heap allocation
+  size_t bytes = sizeof(GUI::Button);
+  if (m_Text.capacity() > std::string().capacity())
+    bytes += m_Text.capacity()+1;
+
+  report.Add("widget", "Button", bytes);
+}
@@ -0,0 +1,145 @@
+#include "../../include/gui.hpp"
+
+static Rectangle Intersect(Rectangle a, Rectangle b) noexcept
+{
+  float left = a.x > b.x ? a.x : b.x;
+  float top = a.y > b.y ? a.y : b.y;
+  float right = a.x+a.width < b.x+b.width ? a.x+a.width : b.x+b.width;
+  float bottom = a.y+a.height < b.y+b.height ? a.y+a.height : b.y+b.height;
+
+  return { left, top, right > left ? right-left : 0, bottom > top ? bottom-top : 0 };
+}
+
+GUI::ClipStack::ClipStack(void)
+  : m_Depth(0), m_Overflow(0)
+{ }
+
+void GUI::ClipStack::Push(Rectangle rec) noexcept
+{
+  if (m_Depth == MAX_DEPTH)
+  {
+    // Deeper pushes keep clipping to the innermost stored rect, Pop stays balanced
+    if (!m_Overflow++)
+      TraceLog(LOG_WARNING, "GUI: Clip stack deeper than %d", (int)MAX_DEPTH);
+    return;
+  }
+
+  m_Rects[m_Depth] = m_Depth ? Intersect(m_Rects[m_Depth-1], rec) : rec;
+  m_Depth++;
+}
+
+void GUI::ClipStack::Pop(void) noexcept
+{
+  if (m_Overflow)
+    m_Overflow--;
+  else if (m_Depth)
+    m_Depth--;
+}
+
+bool GUI::ClipStack::IsEmpty(void) const noexcept
+{
+  return !m_Depth;
+}
+
+Rectangle GUI::ClipStack::GetRect(void) const noexcept
+{
+  return m_Depth ? m_Rects[m_Depth-1] : Rectangle{ 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() };
+}
+
+bool GUI::ClipStack::IsVisible(Rectangle rec) const noexcept
+{
+  if (!m_Depth)
+    return true;
+
+  Rectangle clip = m_Rects[m_Depth-1];
+  return rec.x < clip.x+clip.width && rec.x+rec.width > clip.x && rec.y < clip.y+clip.height && rec.y+rec.height > clip.y;
+}
+
+void GUI::ClipStack::DrawRectangle(Rectangle rec, Color color) const noexcept
+{
+  if (m_Depth)
+    rec = Intersect(m_Rects[m_Depth-1], rec);
+
+  if (rec.width > 0 && rec.height > 0)
+    DrawRectangleRec(rec, color);
+}
+
+bool GUI::ClipStack::ClipQuad(Rectangle& source, Rectangle& dest) const noexcept
+{
+  if (dest.width <= 0 || dest.height <= 0)
+    return false;
+  if (!m_Depth)
+    return true;
+
+  Rectangle clipped = Intersect(m_Rects[m_Depth-1], dest);
+  if (clipped.width <= 0 || clipped.height <= 0)
+    return false;
+
+  // Trim the texture coordinates by the same fraction the quad lost on each side
+  float scaleX = source.width/dest.width;
+  float scaleY = source.height/dest.height;
+  source.x += (clipped.x-dest.x)*scaleX;
+  source.y += (clipped.y-dest.y)*scaleY;
+  source.width = clipped.width*scaleX;
+  source.height = clipped.height*scaleY;
+  dest = clipped;
+  return true;
+}
+
+void GUI::ClipStack::DrawTexture(Texture2D texture, Rectangle source, Rectangle dest, Color tint) const noexcept
+{
+  if (ClipQuad(source, dest))
+    DrawTexturePro(texture, source, dest, { 0, 0 }, 0, tint);
+}
+
+void GUI::ClipStack::DrawTextEx(Font font, const char* text, Vector2 position, float fontSize, float spacing, Color tint) const noexcept
+{
+  if (!font.glyphs || !font.recs)
+    return;
+
+  // Glyphs never reach further than twice the font size from the pen position
+  Rectangle clip = GetRect();
+  if (position.y > clip.y+clip.height || position.y+fontSize*2 < clip.y)
+    return;
+
+  float scaleFactor = fontSize/font.baseSize;
+  float padding = (float)font.glyphPadding;
+  float textOffsetX = 0;
+
+  for (int i = 0; text[i];)
+  {
+    int next;
+    int codepoint = GetCodepointNext(text+i, &next);
+    int index = GetGlyphIndex(font, codepoint);
+    i += next;
+
+    // Single line text only moves right, nothing after the clip edge can show up again
+    float x = position.x+textOffsetX;
+    if (x > clip.x+clip.width)
+      break;
+
+    if (codepoint != ' ' && codepoint != '\t')
+    {
+      Rectangle source = { font.recs[index].x-padding, font.recs[index].y-padding, font.recs[index].width+padding*2, font.recs[index].height+padding*2 };
+      Rectangle dest = { x+(font.glyphs[index].offsetX-padding)*scaleFactor, position.y+(font.glyphs[index].offsetY-padding)*scaleFactor, source.width*scaleFactor, source.height*scaleFactor };
+      DrawTexture(font.texture, source, dest, tint);
+    }
+
+    if (font.glyphs[index].advanceX)
+      textOffsetX += font.glyphs[index].advanceX*scaleFactor+spacing;
+    else
+      textOffsetX += font.recs[index].width*scaleFactor+spacing;
+  }
+}
+
+void GUI::ClipStack::BeginScissor(void) const noexcept
+{
+  if (m_Depth)
+    BeginScissorMode(m_Rects[m_Depth-1].x, m_Rects[m_Depth-1].y, m_Rects[m_Depth-1].width, m_Rects[m_Depth-1].height);
+}
+
+void GUI::ClipStack::EndScissor(void) const noexcept
+{
+  if (m_Depth)
+    EndScissorMode();
+}
@@ -0,0 +1,172 @@
+#include "../../include/gui.hpp"
+
+#include <math.h>
+
+GUI::Context::Context(void)
+  : m_Scale(1), m_AutoScale(true)
+{
+  if (IsWindowReady())
+    m_Scale = GetMonitorScale();
+}
+
+GUI::Context::~Context(void)
+{
+  if (!IsWindowReady())
+    return;
+
+  for (FontEntry& entry : m_Fonts)
+    UnloadFont(entry.font);
+  UnloadRetiredFonts();
+  GUI::Text::InvalidateGlyphTables();
+}
+
+float GUI::Context::GetMonitorScale(void) const noexcept
+{
+  return GetMonitorWidth(GetCurrentMonitor())/1000.0f;
+}
+
+bool GUI::Context::BakeFonts(void) noexcept
+{
+  bool changed = false;
+
+  // Only atlases whose pixel size actually changes are rasterized again
+  for (FontEntry& entry : m_Fonts)
+  {
+    int bakedSize = (int)roundf(entry.fontSize*m_Scale);
+    if (bakedSize < 1)
+      bakedSize = 1;
+    if (bakedSize == entry.bakedSize)
+      continue;
+
+    // Widgets still hold the old font by value, it goes on the next Update once their styles were re-applied
+    if (entry.bakedSize)
+      m_RetiredFonts.push_back(entry.font);
+
+#ifdef GUI_BAKED_FONTS
+    // Sizes baked into the executable skip rasterizing the TTF, a near size is scaled
+    if (!GUI::LoadBakedFont(GUI::bakedFonts, GUI::bakedFontsSize, entry.fileName.c_str(), bakedSize, entry.font))
+    {
+      TraceLog(LOG_WARNING, "GUI: no baked atlas of %s near %d px, rasterizing the TTF", GetFileName(entry.fileName.c_str()), bakedSize);
+      entry.font = LoadFontEx(entry.fileName.c_str(), bakedSize, nullptr, 0);
+    }
+#else
+    entry.font = LoadFontEx(entry.fileName.c_str(), bakedSize, nullptr, 0);
+#endif
+    entry.bakedSize = bakedSize;
+    changed = true;
+  }
+
+  return changed;
+}
+
+void GUI::Context::UnloadRetiredFonts(void) noexcept
+{
+  if (m_RetiredFonts.empty())
+    return;
+
+  for (Font& font : m_RetiredFonts)
+    UnloadFont(font);
+  m_RetiredFonts.clear();
+  GUI::Text::InvalidateGlyphTables();
+}
+
+bool GUI::Context::Update(void) noexcept
+{
+  UnloadRetiredFonts();
+  if (!m_AutoScale)
+    return false;
+
+  float scale = GetMonitorScale();
+  if (scale <= 0 || scale == m_Scale)
+    return false;
+
+  m_Scale = scale;
+  BakeFonts();
+  return true;
+}
+
+void GUI::Context::SetScale(float scale) noexcept
+{
+  m_AutoScale = false;
+  m_Scale = scale;
+  BakeFonts();
+}
+
+float GUI::Context::GetScale(void) const noexcept
+{
+  return m_Scale;
+}
+
+GUI::FontHandle GUI::Context::LoadFont(const std::string& fileName, float fontSize)
+{
+  for (size_t i = 0; i < m_Fonts.size(); i++)
+  {
+    if (m_Fonts[i].fileName == fileName && m_Fonts[i].fontSize == fontSize)
+      return i;
+  }
+
+  m_Fonts.push_back({ fileName, fontSize, 0, Font() });
+  BakeFonts();
+
+  return m_Fonts.size()-1;
+}
+
+Font GUI::Context::GetFont(GUI::FontHandle font) const noexcept
+{
+  return m_Fonts[font].font;
+}
+
+float GUI::Context::Scale(float value) const noexcept
+{
+  return value*m_Scale;
+}
+
+Rectangle GUI::Context::Scale(Rectangle bounds) const noexcept
+{
+  return { bounds.x*m_Scale, bounds.y*m_Scale, bounds.width*m_Scale, bounds.height*m_Scale };
+}
+
+GUI::ButtonStyle GUI::Context::Scale(GUI::ButtonStyle style, GUI::FontHandle font) const noexcept
+{
+  // Text is drawn at exactly the baked size so glyphs map 1:1 to pixels
+  style.font = m_Fonts[font].font;
+  style.fontSize = m_Fonts[font].bakedSize;
+  style.outlineThickness *= m_Scale;
+  style.outlineDistance *= m_Scale;
+  style.hoverOutlineOffset *= m_Scale;
+  style.iconSize *= m_Scale;
+  style.iconSpacing *= m_Scale;
+
+  return style;
+}
+
+GUI::InputStyle GUI::Context::Scale(GUI::InputStyle style, GUI::FontHandle font) const noexcept
+{
+  style.font = m_Fonts[font].font;
+  style.fontSize = m_Fonts[font].bakedSize;
+  style.outlineThickness *= m_Scale;
+  style.outlineDistance *= m_Scale;
+
+  return style;
+}
+
+void GUI::Context::ReportMemory(GUI::MemoryReport& report) const
+{
+  for (const FontEntry& entry : m_Fonts)
+  {
+    const Font& font = entry.font;
+    std::string name = std::string(GetFileName(entry.fileName.c_str()))+" "+std::to_string(font.baseSize);
+
+    // LoadFontEx keeps a rasterized image per glyph next to the atlas
+    size_t bytes = sizeof(FontEntry)+entry.fileName.capacity()+font.glyphCount*(sizeof(GlyphInfo)+sizeof(Rectangle));
+    for (int i = 0; font.glyphs && i < font.glyphCount; i++)
+    {
+      if (font.glyphs[i].image.data)
+        bytes += GetPixelDataSize(font.glyphs[i].image.width, font.glyphs[i].image.height, font.glyphs[i].image.format);
+    }
+
+    report.Add("font", name, bytes);
+    if (font.texture.id)
+      report.Add("texture", name, GetPixelDataSize(font.texture.width, font.texture.height, font.texture.format));
+  }
+}
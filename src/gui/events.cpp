@@ -0,0 +1,79 @@
+#include "../../include/gui.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+  struct HandlerOrder
+  {
+    // Pointers are only ordered reliably through std::less
+    template <typename T>
+    bool operator()(const T& handler, const void* widget) const noexcept { return std::less<const void*>()(handler.widget, widget); }
+    template <typename T>
+    bool operator()(const void* widget, const T& handler) const noexcept { return std::less<const void*>()(widget, handler.widget); }
+  };
+}
+
+GUI::EventQueue::EventQueue(void)
+{ }
+
+void GUI::EventQueue::AddHandler(GUI::EventTypes type, const void* widget, GUI::EventHandler handler, void* userData)
+{
+  if (type >= EVENT_TYPE_COUNT || !handler)
+    return;
+
+  // Inserted after equal widgets so handlers of one widget run in the order they were added
+  std::vector<Handler>& handlers = m_Handlers[type];
+  handlers.insert(std::upper_bound(handlers.begin(), handlers.end(), widget, HandlerOrder()), { widget, handler, userData });
+}
+
+void GUI::EventQueue::RemoveHandlers(const void* widget) noexcept
+{
+  for (std::vector<Handler>& handlers : m_Handlers)
+  {
+    std::pair<std::vector<Handler>::iterator, std::vector<Handler>::iterator> range = std::equal_range(handlers.begin(), handlers.end(), widget, HandlerOrder());
+    handlers.erase(range.first, range.second);
+  }
+}
+
+void GUI::EventQueue::Push(GUI::EventTypes type, const void* widget)
+{
+  // Nobody listens for this type, so there is nothing to queue
+  if (type < EVENT_TYPE_COUNT && !m_Handlers[type].empty())
+    m_Events.push_back({ type, widget });
+}
+
+void GUI::EventQueue::Deliver(const GUI::Event& event, const void* widget)
+{
+  const std::vector<Handler>& handlers = m_Handlers[event.type];
+  std::pair<std::vector<Handler>::const_iterator, std::vector<Handler>::const_iterator> range = std::equal_range(handlers.begin(), handlers.end(), widget, HandlerOrder());
+
+  // Indexed rather than iterated, a handler may add or remove handlers while it runs
+  for (size_t i = range.first-handlers.begin(), end = range.second-handlers.begin(); i < end && i < m_Handlers[event.type].size(); i++)
+  {
+    Handler handler = m_Handlers[event.type][i];
+    handler.handler(event, handler.userData);
+  }
+}
+
+void GUI::EventQueue::Dispatch(void)
+{
+  // Events pushed by handlers are delivered on the next Dispatch
+  m_Dispatching.swap(m_Events);
+  m_Events.clear();
+
+  for (const GUI::Event& event : m_Dispatching)
+  {
+    Deliver(event, nullptr);
+    if (event.widget)
+      Deliver(event, event.widget);
+  }
+
+  m_Dispatching.clear();
+}
+
+size_t GUI::EventQueue::GetEventCount(void) const noexcept
+{
+  return m_Events.size();
+}
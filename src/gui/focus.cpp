@@ -0,0 +1,188 @@
+#include "../../include/gui.hpp"
+
+
+GUI::FocusManager::FocusManager(void)
+  : m_Holes(0), m_Focused(nullptr), m_FocusClaimed(false), m_Keys(), m_KeyCount(0), m_Chars(), m_CharCount(0), m_KeysDown()
+{ }
+
+void GUI::FocusManager::BeginFrame(void) noexcept
+{
+  // raylib's queues are global, draining them here keeps unfocused widgets from stealing events
+  m_KeyCount = 0;
+  for (int key = GetKeyPressed(); key; key = GetKeyPressed())
+  {
+    if (m_KeyCount < MAX_EVENTS)
+      m_Keys[m_KeyCount++] = key;
+  }
+
+  m_CharCount = 0;
+  for (int codepoint = GetCharPressed(); codepoint; codepoint = GetCharPressed())
+  {
+    if (m_CharCount < MAX_EVENTS)
+      m_Chars[m_CharCount++] = codepoint;
+  }
+
+  m_FocusClaimed = false;
+}
+
+void GUI::FocusManager::EndFrame(const GUI::MouseState& mouseState) noexcept
+{
+  // A Tab the focused widget did not consume moves focus
+  for (size_t i = 0; i < m_KeyCount; i++)
+  {
+    if (m_Keys[i] == KEY_TAB)
+      FocusNext(IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT));
+  }
+
+  if (!m_FocusClaimed && mouseState.pressed)
+    ClearFocus();
+}
+
+void GUI::FocusManager::Register(const void* widget)
+{
+  if (!widget || m_Positions.count(widget))
+    return;
+
+  m_Positions.emplace(widget, m_Order.size());
+  m_Order.push_back(widget);
+}
+
+void GUI::FocusManager::Unregister(const void* widget) noexcept
+{
+  if (m_Focused == widget)
+    m_Focused = nullptr;
+
+  std::unordered_map<const void*, size_t>::iterator found = m_Positions.find(widget);
+  if (found == m_Positions.end())
+    return;
+
+  // Leaves a hole so Tab order survives, holes are squeezed out once they are half the list
+  m_Order[found->second] = nullptr;
+  m_Positions.erase(found);
+  m_Holes++;
+
+  if (m_Holes*2 > m_Order.size())
+  {
+    size_t count = 0;
+    for (size_t i = 0; i < m_Order.size(); i++)
+    {
+      if (!m_Order[i])
+        continue;
+
+      m_Positions[m_Order[i]] = count;
+      m_Order[count++] = m_Order[i];
+    }
+
+    m_Order.resize(count);
+    m_Holes = 0;
+  }
+}
+
+void GUI::FocusManager::SetFocus(const void* widget) noexcept
+{
+  m_Focused = widget;
+  m_FocusClaimed = true;
+}
+
+void GUI::FocusManager::ClearFocus(void) noexcept
+{
+  m_Focused = nullptr;
+}
+
+bool GUI::FocusManager::HasFocus(const void* widget) const noexcept
+{
+  return widget && m_Focused == widget;
+}
+
+const void* GUI::FocusManager::GetFocused(void) const noexcept
+{
+  return m_Focused;
+}
+
+void GUI::FocusManager::FocusNext(bool reverse) noexcept
+{
+  size_t size = m_Order.size();
+  if (size == m_Holes)
+    return;
+
+  std::unordered_map<const void*, size_t>::const_iterator found = m_Positions.find(m_Focused);
+  size_t index = found != m_Positions.end() ? found->second : (reverse ? 0 : size-1);
+
+  do
+    index = reverse ? (index+size-1)%size : (index+1)%size;
+  while (!m_Order[index]);
+
+  m_Focused = m_Order[index];
+}
+
+size_t GUI::FocusManager::GetKeyCount(void) const noexcept
+{
+  return m_KeyCount;
+}
+
+const int* GUI::FocusManager::GetKeys(void) const noexcept
+{
+  return m_Keys;
+}
+
+size_t GUI::FocusManager::GetCharCount(void) const noexcept
+{
+  return m_CharCount;
+}
+
+const int* GUI::FocusManager::GetChars(void) const noexcept
+{
+  return m_Chars;
+}
+
+void GUI::FocusManager::ConsumeKey(int key) noexcept
+{
+  for (size_t i = 0; i < m_KeyCount; i++)
+  {
+    if (m_Keys[i] == key)
+      m_Keys[i] = KEY_NULL;
+  }
+}
+
+void GUI::FocusManager::PushKey(int key) noexcept
+{
+  if (key > KEY_NULL && m_KeyCount < MAX_EVENTS)
+    m_Keys[m_KeyCount++] = key;
+}
+
+void GUI::FocusManager::PushChar(int codepoint) noexcept
+{
+  if (codepoint > 0 && m_CharCount < MAX_EVENTS)
+    m_Chars[m_CharCount++] = codepoint;
+}
+
+void GUI::FocusManager::SetKeyDown(int key, bool down) noexcept
+{
+  if (key <= KEY_NULL || key >= MAX_KEYS)
+    return;
+
+  if (down)
+    m_KeysDown[key/64] |= (uint64_t)1 << (key%64);
+  else
+    m_KeysDown[key/64] &= ~((uint64_t)1 << (key%64));
+}
+
+bool GUI::FocusManager::IsKeyPressed(int key) const noexcept
+{
+  for (size_t i = 0; i < m_KeyCount; i++)
+  {
+    if (m_Keys[i] == key)
+      return true;
+  }
+
+  return false;
+}
+
+bool GUI::FocusManager::IsKeyDown(int key) const noexcept
+{
+  // Held on the local keyboard or on a remote one
+  if (key > KEY_NULL && key < MAX_KEYS && (m_KeysDown[key/64] >> (key%64) & 1))
+    return true;
+
+  return ::IsKeyDown(key);
+}
@@ -0,0 +1,94 @@
+#include "../../include/gui.hpp"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+  // A baked atlas further than this from the requested size blurs or blocks, the TTF is rasterized instead
+  constexpr float MAX_SCALE_ERROR = 0.25f;
+}
+
+bool GUI::LoadBakedFont(const unsigned char* blob, size_t size, const char* fileName, int fontSize, Font& font) noexcept
+{
+  if (!blob || size < sizeof(GUI::FontBlobHeader))
+    return false;
+
+  const GUI::FontBlobHeader& header = *(const GUI::FontBlobHeader*)blob;
+  if (memcmp(header.magic, "GUIF", 4) || header.version != FONT_BLOB_VERSION)
+    return false;
+  if (header.fontCount > (size-sizeof(GUI::FontBlobHeader))/sizeof(GUI::FontBlobEntry))
+    return false;
+
+  // Entries are keyed by the font's file name without its directory, so assets can move
+  const char* name = GetFileName(fileName);
+  const GUI::FontBlobEntry* entries = (const GUI::FontBlobEntry*)(blob+sizeof(GUI::FontBlobHeader));
+
+  // Without an exact size the nearest one is loaded, text is drawn scaled by fontSize/baseSize like any other font
+  const GUI::FontBlobEntry* nearest = nullptr;
+  for (uint32_t i = 0; i < header.fontCount; i++)
+  {
+    const GUI::FontBlobEntry& entry = entries[i];
+    if (entry.baseSize <= 0 || entry.name >= size || strncmp((const char*)blob+entry.name, name, size-entry.name))
+      continue;
+
+    // Ties go to the larger size, shrinking an atlas looks better than growing one
+    int distance = abs(entry.baseSize-fontSize);
+    if (!nearest || distance < abs(nearest->baseSize-fontSize) || (distance == abs(nearest->baseSize-fontSize) && entry.baseSize > nearest->baseSize))
+      nearest = &entry;
+  }
+
+  if (nearest && nearest->baseSize != fontSize)
+  {
+    if (fabsf((float)nearest->baseSize/fontSize-1) > MAX_SCALE_ERROR)
+      nearest = nullptr;
+    else
+      TraceLog(LOG_INFO, "GUI: %s has no %d px baked atlas, scaling the %d px one", name, fontSize, nearest->baseSize);
+  }
+
+  if (nearest)
+  {
+    const GUI::FontBlobEntry& entry = *nearest;
+
+    size_t glyphBytes = (size_t)entry.glyphCount*sizeof(GUI::FontBlobGlyph);
+    size_t atlasBytes = (size_t)entry.atlasWidth*entry.atlasHeight;
+    if (entry.glyphCount <= 0 || entry.atlasWidth <= 0 || entry.atlasHeight <= 0 || entry.glyphOffset % 4)
+      return false;
+    if (entry.glyphOffset > size || glyphBytes > size-entry.glyphOffset || entry.atlasOffset > size || atlasBytes > size-entry.atlasOffset)
+      return false;
+
+    // Allocated with raylib's allocator so the result can be released with UnloadFont
+    font.baseSize = entry.baseSize;
+    font.glyphCount = entry.glyphCount;
+    font.glyphPadding = entry.glyphPadding;
+    font.recs = (Rectangle*)MemAlloc(entry.glyphCount*sizeof(Rectangle));
+    font.glyphs = (GlyphInfo*)MemAlloc(entry.glyphCount*sizeof(GlyphInfo));
+
+    const GUI::FontBlobGlyph* glyphs = (const GUI::FontBlobGlyph*)(blob+entry.glyphOffset);
+    for (int32_t j = 0; j < entry.glyphCount; j++)
+    {
+      font.recs[j] = glyphs[j].rec;
+      font.glyphs[j].value = glyphs[j].value;
+      font.glyphs[j].offsetX = glyphs[j].offsetX;
+      font.glyphs[j].offsetY = glyphs[j].offsetY;
+      font.glyphs[j].advanceX = glyphs[j].advanceX;
+    }
+
+    // The blob only keeps coverage, the texture wants the same gray+alpha layout as LoadFontEx
+    const unsigned char* coverage = blob+entry.atlasOffset;
+    Image atlas = { MemAlloc(atlasBytes*2), entry.atlasWidth, entry.atlasHeight, 1, PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA };
+    unsigned char* pixels = (unsigned char*)atlas.data;
+    for (size_t j = 0; j < atlasBytes; j++)
+    {
+      pixels[j*2] = 255;
+      pixels[j*2+1] = coverage[j];
+    }
+
+    font.texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    return true;
+  }
+
+  return false;
+}
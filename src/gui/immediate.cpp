@@ -0,0 +1,564 @@
+#include "../../include/gui.hpp"
+
+#include <math.h>
+#include <string.h>
+
+static inline size_t HomeSlot(GUI::WidgetId id, size_t mask) noexcept
+{
+  return (id*2654435761u) & mask;
+}
+
+static GUI::WidgetId HashBytes(GUI::WidgetId seed, const unsigned char* bytes, size_t length) noexcept
+{
+  // FNV-1a, seeded with the enclosing id so the same name can repeat in different scopes
+  uint32_t hash = seed;
+  for (size_t i = 0; i < length; i++)
+    hash = (hash ^ bytes[i])*16777619u;
+
+  return hash ? hash : 1;
+}
+
+GUI::WidgetTable::WidgetTable(void)
+  : m_Slots(64, GUI::WidgetState()), m_Count(0)
+{ }
+
+void GUI::WidgetTable::Grow(void) noexcept
+{
+  std::vector<GUI::WidgetState> slots(m_Slots.size()*2, GUI::WidgetState());
+  size_t mask = slots.size()-1;
+
+  for (const GUI::WidgetState& state : m_Slots)
+  {
+    if (!state.id)
+      continue;
+
+    size_t i = HomeSlot(state.id, mask);
+    while (slots[i].id)
+      i = (i+1) & mask;
+    slots[i] = state;
+  }
+
+  m_Slots.swap(slots);
+}
+
+GUI::WidgetState& GUI::WidgetTable::Touch(GUI::WidgetId id, uint32_t frame) noexcept
+{
+  // Kept at most half full so probe runs stay short
+  if ((m_Count+1)*2 > m_Slots.size())
+    Grow();
+
+  size_t mask = m_Slots.size()-1;
+  for (size_t i = HomeSlot(id, mask);; i = (i+1) & mask)
+  {
+    GUI::WidgetState& state = m_Slots[i];
+    if (state.id == id)
+    {
+      state.lastFrame = frame;
+      return state;
+    }
+
+    if (!state.id)
+    {
+      state = GUI::WidgetState();
+      state.id = id;
+      state.lastFrame = frame;
+      m_Count++;
+      return state;
+    }
+  }
+}
+
+GUI::WidgetState* GUI::WidgetTable::Find(GUI::WidgetId id) noexcept
+{
+  size_t mask = m_Slots.size()-1;
+  for (size_t i = HomeSlot(id, mask); m_Slots[i].id; i = (i+1) & mask)
+  {
+    if (m_Slots[i].id == id)
+      return &m_Slots[i];
+  }
+
+  return nullptr;
+}
+
+void GUI::WidgetTable::Collect(uint32_t frame) noexcept
+{
+  size_t mask = m_Slots.size()-1;
+
+  for (size_t i = 0; i < m_Slots.size();)
+  {
+    if (!m_Slots[i].id || m_Slots[i].lastFrame == frame)
+    {
+      i++;
+      continue;
+    }
+
+    // Backward-shift deletion keeps every probe chain intact without tombstones,
+    // slot i is looked at again since an entry may have moved into it
+    size_t hole = i;
+    for (size_t j = (hole+1) & mask; m_Slots[j].id; j = (j+1) & mask)
+    {
+      size_t home = HomeSlot(m_Slots[j].id, mask);
+      if (((j-home) & mask) >= ((j-hole) & mask))
+      {
+        m_Slots[hole] = m_Slots[j];
+        hole = j;
+      }
+    }
+
+    m_Slots[hole].id = 0;
+    m_Count--;
+  }
+}
+
+size_t GUI::WidgetTable::GetSize(void) const noexcept
+{
+  return m_Count;
+}
+
+size_t GUI::WidgetTable::GetCapacity(void) const noexcept
+{
+  return m_Slots.size();
+}
+
+GUI::ImContext::ImContext(void)
+  : m_MouseState(nullptr), m_Frame(0), m_FrameTime(0), m_IdStack(), m_IdDepth(0), m_Focused(0), m_HeldKey(0), m_HeldTime(0), m_RepeatTime(0), m_Animating(false)
+{ }
+
+void GUI::ImContext::BeginFrame(GUI::MouseState& mouseState) noexcept
+{
+  m_MouseState = &mouseState;
+  m_Frame++;
+  m_IdDepth = 0;
+  m_Animating = false;
+
+  // Same clamp as the Animator, a frame after an idle wait should not skip transitions
+  m_FrameTime = GetFrameTime();
+  if (m_FrameTime > 1/30.0f)
+    m_FrameTime = 1/30.0f;
+}
+
+void GUI::ImContext::EndFrame(void) noexcept
+{
+  m_Table.Collect(m_Frame);
+
+  if (m_Focused && !m_Table.Find(m_Focused))
+    m_Focused = 0;
+}
+
+void GUI::ImContext::PushId(const char* id) noexcept
+{
+  if (m_IdDepth < sizeof(m_IdStack)/sizeof(m_IdStack[0]))
+    m_IdStack[m_IdDepth] = GetId(id);
+  m_IdDepth++;
+}
+
+void GUI::ImContext::PushId(size_t index) noexcept
+{
+  if (m_IdDepth < sizeof(m_IdStack)/sizeof(m_IdStack[0]))
+    m_IdStack[m_IdDepth] = HashBytes(m_IdDepth ? m_IdStack[m_IdDepth-1] : 2166136261u, (const unsigned char*)&index, sizeof(index));
+  m_IdDepth++;
+}
+
+void GUI::ImContext::PopId(void) noexcept
+{
+  if (m_IdDepth)
+    m_IdDepth--;
+}
+
+GUI::WidgetId GUI::ImContext::GetId(const char* id) const noexcept
+{
+  size_t depth = m_IdDepth < sizeof(m_IdStack)/sizeof(m_IdStack[0]) ? m_IdDepth : sizeof(m_IdStack)/sizeof(m_IdStack[0]);
+  return HashBytes(depth ? m_IdStack[depth-1] : 2166136261u, (const unsigned char*)id, strlen(id));
+}
+
+GUI::WidgetState& GUI::ImContext::GetState(GUI::WidgetId id) noexcept
+{
+  return m_Table.Touch(id, m_Frame);
+}
+
+GUI::MouseState& GUI::ImContext::GetMouseState(void) noexcept
+{
+  return *m_MouseState;
+}
+
+float GUI::ImContext::Transition(float& progress, float target, float transitionTime) noexcept
+{
+  // Widget state moves around in the table, so transitions are stepped here instead of by the Animator
+  if (transitionTime <= 0)
+    progress = target;
+  else if (progress < target)
+    progress = fminf(target, progress+m_FrameTime/transitionTime);
+  else if (progress > target)
+    progress = fmaxf(target, progress-m_FrameTime/transitionTime);
+
+  if (progress != target)
+    m_Animating = true;
+
+  return progress*progress*(3-2*progress);
+}
+
+bool GUI::ImContext::IsKeyRepeated(int key) noexcept
+{
+  if (IsKeyPressed(key))
+  {
+    m_HeldKey = key;
+    m_HeldTime = 0;
+    m_RepeatTime = 0;
+    return true;
+  }
+
+  if (key != m_HeldKey || !IsKeyDown(key))
+    return false;
+
+  // Held keys repeat after half a second, the frames in between must not sleep
+  m_Animating = true;
+  m_HeldTime += m_FrameTime;
+  if (m_HeldTime < 0.5f)
+    return false;
+
+  m_RepeatTime += m_FrameTime;
+  if (m_RepeatTime < 0.05f)
+    return false;
+
+  m_RepeatTime = 0;
+  return true;
+}
+
+bool GUI::ImContext::IsKeyPressed(int key) const noexcept
+{
+  // Through the FocusManager when there is one, so keys from a remote viewer count too
+  if (m_MouseState && m_MouseState->focus)
+    return m_MouseState->focus->IsKeyPressed(key);
+
+  return ::IsKeyPressed(key);
+}
+
+bool GUI::ImContext::IsKeyDown(int key) const noexcept
+{
+  if (m_MouseState && m_MouseState->focus)
+    return m_MouseState->focus->IsKeyDown(key);
+
+  return ::IsKeyDown(key);
+}
+
+bool GUI::ImContext::IsAnimating(void) const noexcept
+{
+  return m_Animating;
+}
+
+GUI::WidgetId GUI::ImContext::GetFocused(void) const noexcept
+{
+  return m_Focused;
+}
+
+void GUI::ImContext::SetFocused(GUI::WidgetId id) noexcept
+{
+  m_Focused = id;
+}
+
+static Vector2 AlignText(const Font& font, const char* text, Rectangle bounds, float fontSize, int textAlignment) noexcept
+{
+  Vector2 position = { bounds.x+5, bounds.y+(bounds.height/2)-(fontSize/2) };
+
+  switch (textAlignment)
+  {
+    case GUI::TEXT_ALIGNMENT_CENTER:
+      position.x = bounds.x+(bounds.width/2)-(GUI::Text::MeasureRange(font, text, strlen(text), fontSize, GUI::SPACING)/2);
+      break;
+    case GUI::TEXT_ALIGNMENT_RIGHT:
+      position.x = bounds.x+bounds.width-5-GUI::Text::MeasureRange(font, text, strlen(text), fontSize, GUI::SPACING);
+      break;
+  }
+
+  return position;
+}
+
+bool GUI::Im::Button(GUI::ImContext& context, const char* id, Rectangle bounds, const GUI::ButtonStyle& style, const char* text) noexcept
+{
+  GUI::WidgetState& state = context.GetState(context.GetId(id));
+  GUI::MouseState& mouseState = context.GetMouseState();
+  bool clicked = false;
+
+  bool hovered = CheckCollisionPointRec(mouseState.position, bounds);
+  float progress = context.Transition(state.hoverProgress, hovered ? 1.0f : 0.0f, style.transitionTime);
+
+  Color backgroundColor = GUI::LerpColor(style.baseBackgroundColor, style.hoverBackgroundColor, progress);
+  Color outlineColor = GUI::LerpColor(style.baseOutlineColor, style.hoverOutlineColor, progress);
+  Color textColor = GUI::LerpColor(style.baseTextColor, style.hoverTextColor, progress);
+  float outlineDistance = style.outlineDistance+style.hoverOutlineOffset*progress;
+
+  float scaleX = (((bounds.width*style.hoverScale)-bounds.width)/2)*progress;
+  float scaleY = (((bounds.height*style.hoverScale)-bounds.height)/2)*progress;
+  Rectangle newBounds = { bounds.x-scaleX/2, bounds.y-scaleY/2, bounds.width+scaleX, bounds.height+scaleY };
+
+  if (hovered)
+  {
+    mouseState.cursor = MOUSE_CURSOR_POINTING_HAND;
+
+    if (!mouseState.clicked && mouseState.pressed)
+    {
+      clicked = true;
+      mouseState.clicked = true;
+    }
+  }
+
+  Rectangle outlineBounds = { newBounds.x-outlineDistance, newBounds.y-outlineDistance, newBounds.width+outlineDistance*2, newBounds.height+outlineDistance*2 };
+  if (style.outlineFill)
+    DrawRectangleRounded(outlineBounds, style.roundness, SEGMENTS, outlineColor);
+  else
+    DrawRectangleRoundedLines(outlineBounds, style.roundness, SEGMENTS, style.outlineThickness, outlineColor);
+
+  DrawRectangleRounded(newBounds, style.roundness, SEGMENTS, backgroundColor);
+  Vector2 textPosition = AlignText(style.font, text, bounds, style.fontSize, style.textAlignment);
+  if (mouseState.textBatcher)
+    mouseState.textBatcher->AddText(style.font, text, textPosition, style.fontSize, SPACING, textColor);
+  else
+    DrawTextEx(style.font, text, textPosition, style.fontSize, SPACING, textColor);
+
+  return clicked;
+}
+
+static bool EraseSelection(std::string& text, GUI::WidgetState& state) noexcept
+{
+  if (state.cursor == state.anchor)
+    return false;
+
+  uint32_t start = state.cursor < state.anchor ? state.cursor : state.anchor;
+  uint32_t end = state.cursor < state.anchor ? state.anchor : state.cursor;
+  text.erase(start, end-start);
+  state.cursor = start;
+  state.anchor = start;
+  return true;
+}
+
+static void InsertAtCursor(std::string& text, GUI::WidgetState& state, const char* bytes, size_t length) noexcept
+{
+  EraseSelection(text, state);
+  text.insert(state.cursor, bytes, length);
+  state.cursor += length;
+  state.anchor = state.cursor;
+}
+
+// Bytes and codepoints that still fit once the selection is replaced
+static void RemainingRoom(const std::string& text, const GUI::WidgetState& state, size_t maxCodepoints, size_t maxBytes, size_t& bytes, size_t& codepoints) noexcept
+{
+  uint32_t start = state.cursor < state.anchor ? state.cursor : state.anchor;
+  uint32_t end = state.cursor < state.anchor ? state.anchor : state.cursor;
+
+  size_t length = text.length()-(end-start);
+  bytes = length < maxBytes ? maxBytes-length : 0;
+
+  // Counting is only paid for when a codepoint limit is set
+  if (maxCodepoints == SIZE_MAX)
+  {
+    codepoints = SIZE_MAX;
+    return;
+  }
+
+  size_t count = GUI::Utf8::CountCodepoints(text.c_str(), text.length())-GUI::Utf8::CountCodepoints(text.c_str()+start, end-start);
+  codepoints = count < maxCodepoints ? maxCodepoints-count : 0;
+}
+
+static bool InsertCodepoint(std::string& text, GUI::WidgetState& state, int codepoint, size_t maxCodepoints, size_t maxBytes) noexcept
+{
+  int size;
+  const char* bytes = CodepointToUTF8(codepoint, &size);
+
+  size_t roomBytes;
+  size_t roomCodepoints;
+  RemainingRoom(text, state, maxCodepoints, maxBytes, roomBytes, roomCodepoints);
+  if ((size_t)size > roomBytes || !roomCodepoints)
+    return false;
+
+  InsertAtCursor(text, state, bytes, size);
+  return true;
+}
+
+bool GUI::Im::Input(GUI::ImContext& context, const char* id, Rectangle bounds, const GUI::InputStyle& style, std::string& text, const char* placeholderText, size_t maxCodepoints, size_t maxBytes) noexcept
+{
+  GUI::WidgetId widgetId = context.GetId(id);
+  GUI::WidgetState& state = context.GetState(widgetId);
+  GUI::MouseState& mouseState = context.GetMouseState();
+  bool changed = false;
+
+  // The caller may have changed the text since the last frame
+  if (state.cursor > text.length())
+    state.cursor = text.length();
+  if (state.anchor > text.length())
+    state.anchor = text.length();
+
+  bool hovered = CheckCollisionPointRec(mouseState.position, bounds);
+  // With a FocusManager the context holds focus for all of its widgets, retained widgets can take it away
+  bool focused = context.GetFocused() == widgetId && (!mouseState.focus || mouseState.focus->HasFocus(&context));
+  float x = mouseState.position.x-bounds.x-5+state.scroll;
+
+  if (hovered)
+    mouseState.cursor = MOUSE_CURSOR_IBEAM;
+
+  if (!mouseState.clicked && mouseState.pressed)
+  {
+    if (hovered)
+    {
+      context.SetFocused(widgetId);
+      if (mouseState.focus)
+        mouseState.focus->SetFocus(&context);
+      focused = true;
+      mouseState.clicked = true;
+      state.cursor = GUI::Text::IndexAtX(style.font, text.c_str(), text.length(), style.fontSize, SPACING, x);
+      state.anchor = state.cursor;
+    }
+    else if (focused)
+    {
+      context.SetFocused(0);
+      focused = false;
+    }
+  }
+  else if (focused && hovered && !mouseState.clicked && mouseState.down)
+  {
+    state.cursor = GUI::Text::IndexAtX(style.font, text.c_str(), text.length(), style.fontSize, SPACING, x);
+  }
+
+  if (focused)
+  {
+    bool shift = context.IsKeyDown(KEY_LEFT_SHIFT) || context.IsKeyDown(KEY_RIGHT_SHIFT);
+    bool control = context.IsKeyDown(KEY_LEFT_CONTROL) || context.IsKeyDown(KEY_RIGHT_CONTROL) || context.IsKeyDown(KEY_LEFT_SUPER) || context.IsKeyDown(KEY_RIGHT_SUPER);
+
+    if (mouseState.focus)
+    {
+      const int* chars = mouseState.focus->GetChars();
+      for (size_t i = 0; i < mouseState.focus->GetCharCount(); i++)
+        changed |= InsertCodepoint(text, state, chars[i], maxCodepoints, maxBytes);
+    }
+    else
+    {
+      for (int codepoint = GetCharPressed(); codepoint; codepoint = GetCharPressed())
+        changed |= InsertCodepoint(text, state, codepoint, maxCodepoints, maxBytes);
+    }
+
+    if (context.IsKeyRepeated(KEY_BACKSPACE))
+    {
+      if (EraseSelection(text, state))
+      {
+        changed = true;
+      }
+      else if (state.cursor)
+      {
+        size_t start = GUI::Utf8::PreviousCodepoint(text.c_str(), state.cursor);
+        text.erase(start, state.cursor-start);
+        state.cursor = start;
+        state.anchor = start;
+        changed = true;
+      }
+    }
+    else if (context.IsKeyRepeated(KEY_DELETE))
+    {
+      if (EraseSelection(text, state))
+      {
+        changed = true;
+      }
+      else if (state.cursor < text.length())
+      {
+        text.erase(state.cursor, GUI::Utf8::NextCodepoint(text.c_str(), text.length(), state.cursor)-state.cursor);
+        changed = true;
+      }
+    }
+
+    if (context.IsKeyRepeated(KEY_LEFT))
+      state.cursor = GUI::Utf8::PreviousCodepoint(text.c_str(), state.cursor);
+    else if (context.IsKeyRepeated(KEY_RIGHT))
+      state.cursor = GUI::Utf8::NextCodepoint(text.c_str(), text.length(), state.cursor);
+    else if (context.IsKeyPressed(KEY_HOME))
+      state.cursor = 0;
+    else if (context.IsKeyPressed(KEY_END))
+      state.cursor = text.length();
+    else if (control && context.IsKeyPressed(KEY_A))
+    {
+      state.anchor = 0;
+      state.cursor = text.length();
+    }
+
+    if (!shift && (context.IsKeyDown(KEY_LEFT) || context.IsKeyDown(KEY_RIGHT) || context.IsKeyDown(KEY_HOME) || context.IsKeyDown(KEY_END)))
+      state.anchor = state.cursor;
+
+    if (control && (context.IsKeyPressed(KEY_C) || context.IsKeyPressed(KEY_X)) && state.cursor != state.anchor)
+    {
+      uint32_t start = state.cursor < state.anchor ? state.cursor : state.anchor;
+      uint32_t end = state.cursor < state.anchor ? state.anchor : state.cursor;
+      SetClipboardText(text.substr(start, end-start).c_str());
+      if (context.IsKeyPressed(KEY_X))
+        changed |= EraseSelection(text, state);
+    }
+    else if (control && context.IsKeyPressed(KEY_V) && GetClipboardText())
+    {
+      // Validated and clamped to the room left, like GUI::Input's paste
+      size_t roomBytes;
+      size_t roomCodepoints;
+      RemainingRoom(text, state, maxCodepoints, maxBytes, roomBytes, roomCodepoints);
+
+      std::string clipboard;
+      GUI::Utf8::Sanitize(GetClipboardText(), roomBytes, roomCodepoints, clipboard);
+      if (clipboard.length())
+      {
+        InsertAtCursor(text, state, clipboard.c_str(), clipboard.length());
+        changed = true;
+      }
+    }
+  }
+
+  float hoverProgress = context.Transition(state.hoverProgress, hovered ? 1.0f : 0.0f, style.transitionTime);
+  float selectProgress = context.Transition(state.activeProgress, focused ? 1.0f : 0.0f, style.transitionTime);
+
+  Color backgroundColor = GUI::LerpColor(GUI::LerpColor(style.baseBackgroundColor, style.hoverBackgroundColor, hoverProgress), style.selectedBackgroundColor, selectProgress);
+  Color outlineColor = GUI::LerpColor(GUI::LerpColor(style.baseOutlineColor, style.hoverOutlineColor, hoverProgress), style.selectedOutlineColor, selectProgress);
+  Color textColor = GUI::LerpColor(GUI::LerpColor(style.baseTextColor, style.hoverTextColor, hoverProgress), style.selectedTextColor, selectProgress);
+
+  Rectangle outlineBounds = { bounds.x-style.outlineDistance, bounds.y-style.outlineDistance, bounds.width+style.outlineDistance*2, bounds.height+style.outlineDistance*2 };
+  if (style.outlineFill)
+    DrawRectangleRounded(outlineBounds, style.roundness, SEGMENTS, outlineColor);
+  else
+    DrawRectangleRoundedLines(outlineBounds, style.roundness, SEGMENTS, style.outlineThickness, outlineColor);
+
+  DrawRectangleRounded(bounds, style.roundness, SEGMENTS, backgroundColor);
+
+  float textY = bounds.y+(bounds.height/2)-(style.fontSize/2);
+  if (text.empty() && !focused)
+  {
+    // No placeholder is passed as nullptr, the batcher and raylib both read the string unchecked
+    Color placeholderColor = GUI::LerpColor(style.basePlaceholderColor, style.hoverPlaceholderColor, hoverProgress);
+    if (placeholderText && mouseState.textBatcher)
+      mouseState.textBatcher->AddText(style.font, placeholderText, { bounds.x+5, textY }, style.fontSize, SPACING, placeholderColor);
+    else if (placeholderText)
+      DrawTextEx(style.font, placeholderText, { bounds.x+5, textY }, style.fontSize, SPACING, placeholderColor);
+    return changed;
+  }
+
+  // Scroll just enough to keep the cursor in view
+  float width = bounds.width-10;
+  float cursorX = GUI::Text::MeasureRange(style.font, text.c_str(), state.cursor, style.fontSize, GUI::SPACING);
+  if (cursorX-state.scroll > width)
+    state.scroll = cursorX-width;
+  else if (cursorX < state.scroll)
+    state.scroll = cursorX;
+
+  if (state.cursor != state.anchor)
+  {
+    float anchorX = GUI::Text::MeasureRange(style.font, text.c_str(), state.anchor, style.fontSize, GUI::SPACING);
+    float left = fmaxf(fminf(cursorX, anchorX)-state.scroll, 0);
+    float right = fminf(fmaxf(cursorX, anchorX)-state.scroll, width);
+    DrawRectangle(bounds.x+5+left, bounds.y+3, right-left, bounds.height-6, GUI::ResolveColor(style.highlightColor));
+  }
+
+  GUI::ClipStack localClip;
+  GUI::ClipStack& clip = mouseState.clip ? *mouseState.clip : localClip;
+  clip.Push({ bounds.x+5, bounds.y, width, bounds.height });
+  if (mouseState.textBatcher)
+    mouseState.textBatcher->AddText(style.font, text.c_str(), { bounds.x+5-state.scroll, textY }, style.fontSize, SPACING, textColor, &clip);
+  else
+    clip.DrawTextEx(style.font, text.c_str(), { bounds.x+5-state.scroll, textY }, style.fontSize, SPACING, textColor);
+  clip.Pop();
+
+  if (focused)
+    DrawRectangle(bounds.x+5+cursorX-state.scroll, bounds.y+3, 2, bounds.height-6, textColor);
+
+  return changed;
+}
@@ -1,339 +1,736 @@
 #include "../../include/gui.hpp"
 
-GUI::Input::Input(void) = default;
+#include <math.h>
 
-GUI::Input::Input(Rectangle bounds, GUI::InputStyle style, const std::string& m_PlaceholderText)
-  : m_Bounds(bounds), m_Style(style), m_PlaceholderText(m_PlaceholderText), m_CursorPosition(0), m_InputText(""), m_Selected(false), m_HighlightText("")
+#include <chrono>
+
+// Bytes between saved validator states, an edit re-runs the DFA from the last one before it
+static constexpr size_t CHECKPOINT_STRIDE = 64;
+
+static size_t HeapBytes(const std::string& text) noexcept
+{
+  // Short strings live in the inline buffer and cost nothing beyond sizeof(std::string)
+  return text.capacity() > std::string().capacity() ? text.capacity()+1 : 0;
+}
+
+static Rectangle PixelRect(float x, float y, float width, float height) noexcept
+{
+  // Whole pixels, like raylib's integer DrawRectangle
+  return { (float)(int)x, (float)(int)y, (float)(int)width, (float)(int)height };
+}
+
+static double Seconds(void) noexcept
+{
+  // raylib's clock only runs with a window, software frames often have none
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool KeyDown(const GUI::FocusManager* focus, int key) noexcept
+{
+  // The FocusManager also knows keys held on a remote viewer
+  return focus ? focus->IsKeyDown(key) : IsKeyDown(key);
+}
+
+GUI::Input::Input(void)
+  : m_CursorPosition(0), m_MaxCodepoints(SIZE_MAX), m_MaxBytes(GUI::INPUT_MAX_BYTES), m_CodepointCount(0), m_Animator(nullptr), m_Validator(nullptr), m_Autocomplete(nullptr), m_FocusManager(nullptr), m_HoverProgress(0), m_SelectProgress(0), m_XOffset(0), m_Style(0), m_ValidatorState(1), m_Selected(false), m_Hovered(false), m_PendingEvents(0)
 { }
 
+GUI::Input::Input(Rectangle bounds, GUI::InputStyle style, const std::string& placeholderText)
+  : m_InputText(""), m_Bounds(bounds), m_CursorPosition(0), m_MaxCodepoints(SIZE_MAX), m_MaxBytes(GUI::INPUT_MAX_BYTES), m_CodepointCount(0), m_Animator(nullptr), m_Validator(nullptr), m_Autocomplete(nullptr), m_FocusManager(nullptr), m_HoverProgress(0), m_SelectProgress(0), m_XOffset(0), m_Style(GUI::Styles::InternInput(style)), m_ValidatorState(1), m_Selected(false), m_Hovered(false), m_PendingEvents(0)
+{
+  SetPlaceholderText(placeholderText);
+}
+
+GUI::Input::~Input(void)
+{
+  if (m_Animator)
+  {
+    m_Animator->Cancel(&m_HoverProgress);
+    m_Animator->Cancel(&m_SelectProgress);
+  }
+
+  if (m_Autocomplete)
+    m_Autocomplete->Cancel(this);
+
+  if (m_FocusManager)
+    m_FocusManager->Unregister(this);
+}
+
+void GUI::Input::SetBounds(Rectangle bounds) noexcept
+{
+  m_Bounds = bounds;
+  m_XOffset = 0;
+}
+
+void GUI::Input::SetStyle(const GUI::InputStyle& style)
+{
+  // Offsets measured with the old font are stale, the caret scrolls the text back into view on the next frame
+  m_Style = GUI::Styles::InternInput(style);
+  m_XOffset = 0;
+
+  if (m_Edit && m_Edit->highlightText.length())
+  {
+    GUI::InputEditState& edit = *m_Edit;
+    size_t start = edit.highlightStart < m_CursorPosition ? edit.highlightStart : m_CursorPosition;
+    edit.highlightBounds.x = MeasureRange(0, start);
+    edit.highlightBounds.y = MeasureRange(start, edit.highlightText.length());
+  }
+}
+
 void GUI::Input::SetPlaceholderText(const std::string& placeholderText) noexcept
 {
-  m_PlaceholderText = placeholderText;
+  // Only inputs that show a placeholder pay for its storage
+  if (placeholderText.empty())
+    m_PlaceholderText.reset();
+  else if (m_PlaceholderText)
+    *m_PlaceholderText = placeholderText;
+  else
+    m_PlaceholderText.reset(new std::string(placeholderText));
 }
 
 void GUI::Input::SetSelected(bool selected) noexcept
 {
   m_Selected = selected;
+
+  if (!m_FocusManager)
+    return;
+  if (selected)
+    m_FocusManager->SetFocus(this);
+  else if (m_FocusManager->HasFocus(this))
+    m_FocusManager->ClearFocus();
 }
 
-size_t GUI::Input::FindLeftOf(const std::string& str, const char toFind, size_t startIndex) noexcept
+void GUI::Input::SetUndoLimit(size_t maxBytes) noexcept
 {
-  if (!startIndex)
-    return 0;
+  GUI::InputEditState& edit = Edit();
+  edit.journal.SetMaxBytes(maxBytes);
+}
 
-  for (size_t i = startIndex-1; i > 0; i--)
-  {
-    if (str[i] == toFind)
-      return i;
-  }
+void GUI::Input::SetMaxLength(size_t maxCodepoints, size_t maxBytes) noexcept
+{
+  m_MaxCodepoints = maxCodepoints;
+  m_MaxBytes = maxBytes;
+}
 
-  return 0;
+bool GUI::Input::Undo(void) noexcept
+{
+  if (!m_Edit)
+    return false;
+
+  GUI::InputEditState& edit = *m_Edit;
+  if (!edit.journal.Undo(m_InputText, m_CursorPosition))
+    return false;
+
+  m_CodepointCount = GUI::Utf8::CountCodepoints(m_InputText.c_str(), m_InputText.length());
+  edit.words.Rebuild(m_InputText);
+  Revalidate(0);
+  OnTextChanged();
+  ClearHighlight();
+  return true;
+}
+
+bool GUI::Input::Redo(void) noexcept
+{
+  if (!m_Edit)
+    return false;
+
+  GUI::InputEditState& edit = *m_Edit;
+  if (!edit.journal.Redo(m_InputText, m_CursorPosition))
+    return false;
+
+  m_CodepointCount = GUI::Utf8::CountCodepoints(m_InputText.c_str(), m_InputText.length());
+  edit.words.Rebuild(m_InputText);
+  Revalidate(0);
+  OnTextChanged();
+  ClearHighlight();
+  return true;
+}
+
+void GUI::Input::SetValidator(const GUI::Validator* validator) noexcept
+{
+  m_Validator = validator && validator->IsCompiled() ? validator : nullptr;
+  m_Checkpoints.assign(1, 1);
+  Revalidate(0);
+}
+
+const GUI::InputStyle& GUI::Input::GetStyle(void) const noexcept
+{
+  return GUI::Styles::GetInput(m_Style);
 }
 
-size_t GUI::Input::FindRightOf(const std::string& str, const char toFind, size_t startIndex) noexcept
+GUI::InputEditState& GUI::Input::Edit(void)
 {
-  for (size_t i = startIndex+1; i < str.length(); i++)
+  // Most inputs on a screen are never edited, their selection, history and word index are built on first use
+  if (!m_Edit)
   {
-    if (str[i] == toFind)
-      return i;
+    m_Edit.reset(new GUI::InputEditState());
+    m_Edit->words.Rebuild(m_InputText);
   }
 
-  return str.length();
+  return *m_Edit;
 }
 
-void GUI::Input::ReplaceAll(std::string& str, const char toReplace, const char replaceWith) noexcept
+void GUI::Input::SetText(const std::string& text) noexcept
 {
-  for (char& c : str)
+  // Goes through the same limits and validator as a paste, and is undone as one step
+  GUI::InputEditState& edit = Edit();
+  ClearHighlight();
+  edit.journal.Seal();
+  if (m_InputText.length())
   {
-    if (c == toReplace)
-      c = replaceWith;
+    EraseText(0, m_InputText.length());
+    edit.journal.Join();
   }
+  Paste(text.c_str());
+  edit.journal.Seal();
 }
 
-void GUI::Input::DrawCursor(void) noexcept
+const std::string& GUI::Input::GetText(void) const noexcept
 {
-  int x = MeasureTextEx(m_Style.font, m_InputText.substr(0, m_CursorPosition).c_str(), m_Style.fontSize, SPACING).x+m_XOffset;
-  if (x >= m_Bounds.width-10) 
+  return m_InputText;
+}
+
+GUI::ValidationStates GUI::Input::GetValidationState(void) const noexcept
+{
+  if (!m_Validator || m_Validator->IsAccepting(m_ValidatorState))
+    return GUI::VALIDATION_STATE_VALID;
+
+  return m_ValidatorState ? GUI::VALIDATION_STATE_INCOMPLETE : GUI::VALIDATION_STATE_INVALID;
+}
+
+void GUI::Input::SetAutocomplete(GUI::Autocomplete* autocomplete) noexcept
+{
+  if (m_Autocomplete)
+    m_Autocomplete->Cancel(this);
+
+  m_Autocomplete = autocomplete;
+}
+
+void GUI::Input::RequestSuggestions(void) noexcept
+{
+  GUI::InputEditState& edit = Edit();
+  if (!m_Autocomplete)
+    return;
+
+  edit.suggestionIndex = 0;
+  if (m_InputText.empty())
+    m_Autocomplete->Cancel(this);
+  else
+    m_Autocomplete->Request(this, m_InputText);
+}
+
+void GUI::Input::OnTextChanged(void) noexcept
+{
+  m_PendingEvents |= 1 << GUI::EVENT_TEXT_CHANGED;
+  RequestSuggestions();
+}
+
+void GUI::Input::PushEvents(GUI::MouseState& mouseState)
+{
+  // Edits happen deep in the key handling, they are flagged there and queued once per frame here
+  if (mouseState.events)
   {
-    size_t textWidth = MeasureTextEx(m_Style.font, m_InputText.c_str(), m_Style.fontSize, SPACING).x;
-    m_XOffset = m_Bounds.width-textWidth-15;
-    x = m_Bounds.width-10;
+    for (int type = 0; type < GUI::EVENT_TYPE_COUNT; type++)
+    {
+      if (m_PendingEvents & (1 << type))
+        mouseState.events->Push((GUI::EventTypes)type, this);
+    }
   }
-  else if (x < 0)
+
+  m_PendingEvents = 0;
+}
+
+void GUI::Input::AcceptSuggestion(const std::string& suggestion) noexcept
+{
+  GUI::InputEditState& edit = Edit();
+  bool erased = m_InputText.length();
+  edit.journal.Seal();
+  if (erased)
   {
-    m_XOffset = 0;
-    x = 0;
+    EraseText(0, m_InputText.length());
+    edit.journal.Join();
   }
+  if (!InsertText(suggestion.c_str(), suggestion.length(), false) && erased)
+    Undo();
+  edit.journal.Seal();
 
-  DrawRectangle(m_Bounds.x+5+x, m_Bounds.y+3, 2, m_Bounds.height-6, WHITE);
+  ClearHighlight();
+  m_Autocomplete->Cancel(this);
 }
 
-void GUI::Input::UpdateCursorPosition(GUI::MouseState& mouseState) noexcept
+void GUI::Input::DrawSuggestions(GUI::MouseState& mouseState) noexcept
 {
-  if (!mouseState.clicked && IsMouseButtonDown(MOUSE_BUTTON_LEFT) && CheckCollisionPointRec(mouseState.position, m_Bounds))
-  {
-    int x = (mouseState.position.x)-m_Bounds.x-m_XOffset;
-    float scaleFactor = m_Style.fontSize/(float)m_Style.font.baseSize;
-    int textWidth = 0;
-    int tempWidth = 0;
-    int byteCount = 0;
-    for (size_t i = 0; i < TextLength(m_InputText.c_str());)
-    {
-      byteCount++;
+  GUI::InputEditState& edit = Edit();
+  const std::vector<std::string>& suggestions = m_Autocomplete->GetSuggestions(this, m_InputText);
+  if (suggestions.empty())
+    return;
 
-      int next;
-      const char letter = GetCodepointNext(m_InputText.c_str()+i, &next);
-      int index = GetGlyphIndex(m_Style.font, letter);
+  // The popup overlaps other widgets, so text queued so far has to land underneath it
+  if (mouseState.textBatcher)
+    mouseState.textBatcher->Flush();
 
-      i += next;
+  GUI::TileRenderer* tiles = mouseState.tiles;
+  Rectangle popup = { m_Bounds.x, m_Bounds.y+m_Bounds.height+GetStyle().outlineDistance+GetStyle().outlineThickness, m_Bounds.width, m_Bounds.height*suggestions.size() };
+  if (tiles)
+    tiles->DrawRectangle(popup, GUI::ResolveColor(GetStyle().baseBackgroundColor));
+  else
+    DrawRectangleRec(popup, GUI::ResolveColor(GetStyle().baseBackgroundColor));
 
-      if (m_Style.font.glyphs[index].advanceX)
-        tempWidth += m_Style.font.glyphs[index].advanceX;
-      else
-        tempWidth += m_Style.font.recs[index].width + m_Style.font.glyphs[index].offsetX;
+  for (size_t i = 0; i < suggestions.size(); i++)
+  {
+    Rectangle row = { popup.x, popup.y+m_Bounds.height*i, popup.width, m_Bounds.height };
+    bool hovered = !mouseState.clicked && CheckCollisionPointRec(mouseState.position, row);
 
-      textWidth = (tempWidth*scaleFactor+(float)((byteCount+10)*SPACING));
+    Color rowColor = GUI::ResolveColor(hovered ? GetStyle().hoverBackgroundColor : GetStyle().highlightColor);
+    Vector2 textPosition = { row.x+5, row.y+(row.height/2)-(GetStyle().fontSize/2) };
+    Color textColor = GUI::ResolveColor(hovered ? GetStyle().hoverTextColor : GetStyle().baseTextColor);
+    if (tiles)
+    {
+      if (hovered || i == edit.suggestionIndex)
+        tiles->DrawRectangle(row, rowColor);
+      tiles->DrawTextEx(tiles->GetFontAtlas(GetStyle().font), GetStyle().font, suggestions[i].c_str(), textPosition, GetStyle().fontSize, SPACING, textColor);
+    }
+    else
+    {
+      if (hovered || i == edit.suggestionIndex)
+        DrawRectangleRec(row, rowColor);
+      DrawTextEx(GetStyle().font, suggestions[i].c_str(), textPosition, GetStyle().fontSize, SPACING, textColor);
+    }
 
-      if (textWidth >= x)
+    if (hovered)
+    {
+      mouseState.cursor = MOUSE_CURSOR_POINTING_HAND;
+      if (mouseState.pressed)
       {
-        m_CursorPosition = i;
-        break;
+        mouseState.clicked = true;
+        AcceptSuggestion(std::string(suggestions[i]));
+        return;
       }
     }
   }
+
+  float thickness = GetStyle().outlineThickness;
+  Color outlineColor = GUI::ResolveColor(GetStyle().baseOutlineColor);
+  if (!tiles)
+  {
+    DrawRectangleLinesEx(popup, thickness, outlineColor);
+    return;
+  }
+
+  // The four sides DrawRectangleLinesEx draws, inside of the popup
+  tiles->DrawRectangle({ popup.x, popup.y, popup.width, thickness }, outlineColor);
+  tiles->DrawRectangle({ popup.x, popup.y+popup.height-thickness, popup.width, thickness }, outlineColor);
+  tiles->DrawRectangle({ popup.x, popup.y+thickness, thickness, popup.height-thickness*2 }, outlineColor);
+  tiles->DrawRectangle({ popup.x+popup.width-thickness, popup.y+thickness, thickness, popup.height-thickness*2 }, outlineColor);
 }
 
-void GUI::Input::UpdateAndRender(GUI::MouseState& mouseState) noexcept
+uint16_t GUI::Input::ValidatorStateAt(size_t offset) noexcept
 {
-  Color backgroundColor = m_Style.baseBackgroundColor;
-  Color outlineColor = m_Style.baseOutlineColor;
-  Color textColor = m_Style.baseTextColor;
+  size_t index = offset/CHECKPOINT_STRIDE;
+  if (index >= m_Checkpoints.size())
+    index = m_Checkpoints.size()-1;
 
-  if (CheckCollisionPointRec(mouseState.position, m_Bounds))
+  // Resume from the nearest checkpoint, saving the ones passed on the way
+  uint16_t state = m_Checkpoints[index];
+  for (size_t position = index*CHECKPOINT_STRIDE; position < offset && state;)
   {
-    backgroundColor = m_Style.hoverBackgroundColor;
-    outlineColor = m_Style.hoverOutlineColor;
-    textColor = m_Style.hoverTextColor;
+    size_t next = (position/CHECKPOINT_STRIDE+1)*CHECKPOINT_STRIDE;
+    if (next > offset)
+      return m_Validator->Run(state, m_InputText.c_str()+position, offset-position);
+
+    state = m_Validator->Run(state, m_InputText.c_str()+position, next-position);
+    if (next/CHECKPOINT_STRIDE == m_Checkpoints.size())
+      m_Checkpoints.push_back(state);
+    position = next;
+  }
 
-    mouseState.cursor = MOUSE_CURSOR_IBEAM;
+  return state;
+}
 
-    if (!mouseState.clicked && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-    {
-      m_Selected = true;
-      mouseState.clicked = true;
-    }
+void GUI::Input::Revalidate(size_t offset) noexcept
+{
+  if (!m_Validator)
+    return;
+
+  // Checkpoints at or before the edit still hold
+  if (m_Checkpoints.size() > offset/CHECKPOINT_STRIDE+1)
+    m_Checkpoints.resize(offset/CHECKPOINT_STRIDE+1);
+
+  m_ValidatorState = ValidatorStateAt(m_InputText.length());
+}
+
+bool GUI::Input::InsertText(const char* text, size_t length, bool coalesce) noexcept
+{
+  GUI::InputEditState& edit = Edit();
+  size_t codepoints = GUI::Utf8::CountCodepoints(text, length);
+  if (!length || m_InputText.length()+length > m_MaxBytes || m_CodepointCount+codepoints > m_MaxCodepoints)
+    return false;
+
+  // Keystrokes and pastes that can never lead to a match are rejected before touching the text
+  if (m_Validator)
+  {
+    uint16_t state = m_Validator->Run(ValidatorStateAt(m_CursorPosition), text, length);
+    if (!m_Validator->Run(state, m_InputText.c_str()+m_CursorPosition, m_InputText.length()-m_CursorPosition))
+      return false;
   }
 
-  if (m_Selected)
+  edit.journal.RecordInsert(m_CursorPosition, text, length, m_CursorPosition, coalesce);
+  m_InputText.insert(m_CursorPosition, text, length);
+  edit.words.Update(m_InputText, m_CursorPosition, 0, length);
+  Revalidate(m_CursorPosition);
+  m_CursorPosition += length;
+  m_CodepointCount += codepoints;
+  OnTextChanged();
+  return true;
+}
+
+void GUI::Input::Paste(const char* text) noexcept
+{
+  if (!text || m_InputText.length() >= m_MaxBytes || m_CodepointCount >= m_MaxCodepoints)
+    return;
+
+  // Validated and clamped to the remaining room first, then applied as a single insert
+  std::string clipboard;
+  GUI::Utf8::Sanitize(text, m_MaxBytes-m_InputText.length(), m_MaxCodepoints-m_CodepointCount, clipboard);
+  InsertText(clipboard.c_str(), clipboard.length(), false);
+}
+
+void GUI::Input::EraseText(size_t offset, size_t length) noexcept
+{
+  GUI::InputEditState& edit = Edit();
+  m_CodepointCount -= GUI::Utf8::CountCodepoints(m_InputText.c_str()+offset, length);
+  edit.journal.RecordErase(offset, m_InputText.c_str()+offset, length, m_CursorPosition, true);
+  m_InputText.erase(offset, length);
+  edit.words.Update(m_InputText, offset, length, 0);
+  Revalidate(offset);
+  m_CursorPosition = offset;
+  OnTextChanged();
+}
+
+void GUI::Input::SelectWordAt(size_t index) noexcept
+{
+  GUI::InputEditState& edit = Edit();
+  size_t start;
+  size_t end;
+  edit.words.SegmentAt(index, start, end);
+
+  edit.highlightStart = start;
+  m_CursorPosition = end;
+  edit.highlightBounds.x = MeasureRange(0, start)+m_XOffset;
+  edit.highlightBounds.y = MeasureRange(start, end-start);
+  edit.highlightText.assign(m_InputText, start, end-start);
+  edit.wordSelecting = true;
+}
+
+void GUI::Input::ClearHighlight(void) noexcept
+{
+  GUI::InputEditState& edit = Edit();
+  edit.highlightText.clear();
+  edit.highlightBounds = { 0, 0 };
+}
+
+void GUI::Input::DrawCursor(GUI::TileRenderer* tiles) noexcept
+{
+  int x = MeasureRange(0, m_CursorPosition)+m_XOffset;
+  if (x >= m_Bounds.width-10) 
   {
-    backgroundColor = m_Style.selectedBackgroundColor;
-    outlineColor = m_Style.selectedOutlineColor;
-    textColor = m_Style.selectedTextColor;
+    size_t textWidth = MeasureRange(0, m_InputText.length());
+    m_XOffset = m_Bounds.width-textWidth-15;
+    x = m_Bounds.width-10;
+  }
+  else if (x < 0)
+  {
+    m_XOffset = 0;
+    x = 0;
   }
 
-  if (m_Style.outlineFill)
-    DrawRectangleRounded({ m_Bounds.x-m_Style.outlineDistance, m_Bounds.y-m_Style.outlineDistance, m_Bounds.width+m_Style.outlineDistance*2, m_Bounds.height+m_Style.outlineDistance*2 }, m_Style.roundness, SEGMENTS, outlineColor);
+  if (tiles)
+    tiles->DrawRectangle(PixelRect(m_Bounds.x+5+x, m_Bounds.y+3, 2, m_Bounds.height-6), WHITE);
   else
-    DrawRectangleRoundedLines({ m_Bounds.x-m_Style.outlineDistance, m_Bounds.y-m_Style.outlineDistance, m_Bounds.width+m_Style.outlineDistance*2, m_Bounds.height+m_Style.outlineDistance*2 }, m_Style.roundness, SEGMENTS, m_Style.outlineThickness, outlineColor);
+    DrawRectangle(m_Bounds.x+5+x, m_Bounds.y+3, 2, m_Bounds.height-6, WHITE);
+}
 
-  DrawRectangleRounded(m_Bounds, m_Style.roundness, SEGMENTS, backgroundColor);
+float GUI::Input::MeasureRange(size_t start, size_t length) const noexcept
+{
+  return GUI::Text::MeasureRange(GetStyle().font, m_InputText.c_str()+start, length, GetStyle().fontSize, SPACING);
+}
 
-  if (!m_InputText.length() && !m_Selected)
+void GUI::Input::UpdateCursorPosition(GUI::MouseState& mouseState) noexcept
+{
+  GUI::InputEditState& edit = Edit();
+  // A double click keeps its word selection until the button is released
+  if (edit.wordSelecting)
+  {
+    edit.wordSelecting = mouseState.down;
+    return;
+  }
+
+  if (!mouseState.clicked && mouseState.down && CheckCollisionPointRec(mouseState.position, m_Bounds))
   {
-    DrawTextEx(m_Style.font, m_PlaceholderText.c_str(), { m_Bounds.x+5, m_Bounds.y+(m_Bounds.height/2)-(m_Style.fontSize/2) }, m_Style.fontSize, SPACING, textColor);
+    float x = mouseState.position.x-m_Bounds.x-5-m_XOffset;
+    m_CursorPosition = GUI::Text::IndexAtX(GetStyle().font, m_InputText.c_str(), m_InputText.length(), GetStyle().fontSize, SPACING, x);
+    edit.journal.Seal();
+  }
+}
+
+void GUI::Input::UpdateTransition(GUI::MouseState& mouseState, float& progress, float target) noexcept
+{
+  if (progress == target)
     return;
+
+  if (mouseState.animator && GetStyle().transitionTime > 0)
+  {
+    m_Animator = mouseState.animator;
+    m_Animator->Animate(&progress, target, GetStyle().transitionTime*fabsf(target-progress));
   }
+  else
+  {
+    progress = target;
+  }
+}
 
-  int key = GetKeyPressed();
+bool GUI::Input::HandleKeyboard(void) noexcept
+{
+  GUI::InputEditState& edit = Edit();
+
+  // Timed here since raylib's frame time stays 0 without a window, a gap longer than a frame means the input was just focused
+  double now = Seconds();
+  float frameTime = now-edit.lastKeyboardTime < 0.1 ? (float)(now-edit.lastKeyboardTime) : 0;
+  edit.lastKeyboardTime = now;
 
-  if (IsKeyDown(KEY_BACKSPACE))
+  if (KeyDown(m_FocusManager, KEY_BACKSPACE))
   {
-    if (m_TimeWaited >= 0.5f)
+    if (edit.timeWaited >= 0.5f)
     {
-      if (m_KeyWaited >= 0.05f && m_CursorPosition) 
+      if (edit.keyWaited >= 0.05f && m_CursorPosition) 
       {
-        m_CursorPosition--;
-        if (m_CursorPosition == m_InputText.length())
-        {
-          m_InputText.pop_back();
-        }
-        else
-        {
-          m_InputText.erase(m_InputText.begin()+m_CursorPosition);
-        }
-        m_KeyWaited = 0;
+        size_t start = GUI::Utf8::PreviousCodepoint(m_InputText.c_str(), m_CursorPosition);
+        EraseText(start, m_CursorPosition-start);
+        edit.keyWaited = 0;
       }
-      m_KeyWaited += GetFrameTime();
+      edit.keyWaited += frameTime;
     }
-    m_TimeWaited += GetFrameTime();
+    edit.timeWaited += frameTime;
   }
-  else if (IsKeyDown(KEY_RIGHT))
+  else if (KeyDown(m_FocusManager, KEY_RIGHT))
   {
-    if (m_TimeWaited >= 0.5f) 
+    if (edit.timeWaited >= 0.5f) 
     {
-      if (m_KeyWaited >= 0.05f && m_CursorPosition < m_InputText.length())
+      if (edit.keyWaited >= 0.05f && m_CursorPosition < m_InputText.length())
       {
-        m_CursorPosition++;  
-        if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT))
+        m_CursorPosition = GUI::Utf8::NextCodepoint(m_InputText.c_str(), m_InputText.length(), m_CursorPosition);
+        if (KeyDown(m_FocusManager, KEY_LEFT_SHIFT) || KeyDown(m_FocusManager, KEY_RIGHT_SHIFT))
         {
-          if (m_CursorPosition < m_HighlightStart)
+          if (m_CursorPosition < edit.highlightStart)
           {
-            m_HighlightBounds.x = MeasureTextEx(m_Style.font, m_InputText.substr(0, m_CursorPosition).c_str(), m_Style.fontSize, SPACING).x+m_XOffset;
-            m_HighlightBounds.y = MeasureTextEx(m_Style.font, m_InputText.substr(m_CursorPosition, m_HighlightStart-m_CursorPosition).c_str(), m_Style.fontSize, SPACING).x;
-            m_HighlightText = m_InputText.substr(m_CursorPosition, m_HighlightStart-m_CursorPosition);
+            edit.highlightBounds.x = MeasureRange(0, m_CursorPosition)+m_XOffset;
+            edit.highlightBounds.y = MeasureRange(m_CursorPosition, edit.highlightStart-m_CursorPosition);
+            edit.highlightText.assign(m_InputText, m_CursorPosition, edit.highlightStart-m_CursorPosition);
           }
           else
           {
-            m_HighlightBounds.x = MeasureTextEx(m_Style.font, m_InputText.substr(0, m_HighlightStart).c_str(), m_Style.fontSize, SPACING).x+m_XOffset;
-            m_HighlightBounds.y = MeasureTextEx(m_Style.font, m_InputText.substr(m_HighlightStart, m_CursorPosition-m_HighlightStart).c_str(), m_Style.fontSize, SPACING).x;
-            m_HighlightText = m_InputText.substr(m_HighlightStart, m_CursorPosition-m_HighlightStart);
+            edit.highlightBounds.x = MeasureRange(0, edit.highlightStart)+m_XOffset;
+            edit.highlightBounds.y = MeasureRange(edit.highlightStart, m_CursorPosition-edit.highlightStart);
+            edit.highlightText.assign(m_InputText, edit.highlightStart, m_CursorPosition-edit.highlightStart);
           }
         }
         else
         {
-          m_HighlightText = "";
-          m_HighlightBounds = { 0 };
+          edit.highlightText.clear();
+          edit.highlightBounds = { 0 };
         }
-        m_KeyWaited = 0;
+        edit.keyWaited = 0;
       }
-      m_KeyWaited += GetFrameTime();
+      edit.keyWaited += frameTime;
     }
-    m_TimeWaited += GetFrameTime();
+    edit.timeWaited += frameTime;
   }
-  else if (IsKeyDown(KEY_LEFT))
+  else if (KeyDown(m_FocusManager, KEY_LEFT))
   {
-    if (m_TimeWaited >= 0.5f) 
+    if (edit.timeWaited >= 0.5f) 
     {
-      if (m_KeyWaited >= 0.05f && m_CursorPosition)
+      if (edit.keyWaited >= 0.05f && m_CursorPosition)
       {
-        m_CursorPosition--;  
-        if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT))
+        m_CursorPosition = GUI::Utf8::PreviousCodepoint(m_InputText.c_str(), m_CursorPosition);
+        if (KeyDown(m_FocusManager, KEY_LEFT_SHIFT) || KeyDown(m_FocusManager, KEY_RIGHT_SHIFT))
         {
-          if (m_CursorPosition > m_HighlightStart)
+          if (m_CursorPosition > edit.highlightStart)
           {
-            m_HighlightBounds.y = MeasureTextEx(m_Style.font, m_InputText.substr(m_HighlightStart, m_CursorPosition-m_HighlightStart).c_str(), m_Style.fontSize, SPACING).x;
-            m_HighlightText = m_InputText.substr(m_HighlightStart, m_CursorPosition-m_HighlightStart); 
+            edit.highlightBounds.y = MeasureRange(edit.highlightStart, m_CursorPosition-edit.highlightStart);
+            edit.highlightText.assign(m_InputText, edit.highlightStart, m_CursorPosition-edit.highlightStart); 
           }
           else
           {
-            m_HighlightBounds.x = MeasureTextEx(m_Style.font, m_InputText.substr(0, m_CursorPosition).c_str(), m_Style.fontSize, SPACING).x+m_XOffset;
-            m_HighlightBounds.y = MeasureTextEx(m_Style.font, m_InputText.substr(m_CursorPosition, m_HighlightStart-m_CursorPosition).c_str(), m_Style.fontSize, SPACING).x;
-            m_HighlightText = m_InputText.substr(m_CursorPosition, m_HighlightStart-m_CursorPosition);
+            edit.highlightBounds.x = MeasureRange(0, m_CursorPosition)+m_XOffset;
+            edit.highlightBounds.y = MeasureRange(m_CursorPosition, edit.highlightStart-m_CursorPosition);
+            edit.highlightText.assign(m_InputText, m_CursorPosition, edit.highlightStart-m_CursorPosition);
           }
         }
         else
         {
-          m_HighlightText = "";
-          m_HighlightBounds = { 0 };
+          edit.highlightText.clear();
+          edit.highlightBounds = { 0 };
         }
-        m_KeyWaited = 0;
+        edit.keyWaited = 0;
       }
-      m_KeyWaited += GetFrameTime();
+      edit.keyWaited += frameTime;
     }
-    m_TimeWaited += GetFrameTime();
+    edit.timeWaited += frameTime;
   }
   else
   {
-    m_TimeWaited = 0;
+    edit.timeWaited = 0;
   }
 
+  // Any of the keys above repeats on the frames after this one
+  bool repeating = KeyDown(m_FocusManager, KEY_BACKSPACE) || KeyDown(m_FocusManager, KEY_RIGHT) || KeyDown(m_FocusManager, KEY_LEFT);
+
+  if (!m_FocusManager)
+  {
+    HandleKey(GetKeyPressed(), true);
+    return repeating;
+  }
+
+  // Text comes from the char queue, so it follows the keyboard layout and is not limited to ASCII
+  const int* keys = m_FocusManager->GetKeys();
+  for (size_t i = 0; i < m_FocusManager->GetKeyCount(); i++)
+    HandleKey(keys[i], false);
+
+  const int* chars = m_FocusManager->GetChars();
+  for (size_t i = 0; i < m_FocusManager->GetCharCount(); i++)
+  {
+    int size;
+    const char* bytes = CodepointToUTF8(chars[i], &size);
+    InsertText(bytes, size, true);
+  }
+
+  return repeating;
+}
+
+void GUI::Input::HandleKey(int key, bool typeCharacters) noexcept
+{
+  GUI::InputEditState& edit = Edit();
   switch (key)
   {
     case KEY_BACKSPACE:
+    {
       if (!m_CursorPosition)
         break;
 
-      m_CursorPosition--;
-      if (m_CursorPosition == m_InputText.length())
-        m_InputText.pop_back();
-      else
-        m_InputText.erase(m_InputText.begin()+m_CursorPosition);
+      // Whole codepoints, so pasted or typed non-ASCII text never loses half a sequence
+      size_t start = GUI::Utf8::PreviousCodepoint(m_InputText.c_str(), m_CursorPosition);
+      EraseText(start, m_CursorPosition-start);
       break;
+    }
     case KEY_LEFT_SHIFT:
-      m_HighlightStart = m_CursorPosition;
-      m_HighlightBounds.x = MeasureTextEx(m_Style.font, m_InputText.substr(0, m_CursorPosition).c_str(), m_Style.fontSize, SPACING).x;
+      edit.highlightStart = m_CursorPosition;
+      edit.highlightBounds.x = MeasureRange(0, m_CursorPosition);
       break;
     case KEY_RIGHT_SHIFT:
-      m_HighlightStart = m_CursorPosition;
-      m_HighlightBounds.x = MeasureTextEx(m_Style.font, m_InputText.substr(0, m_CursorPosition).c_str(), m_Style.fontSize, SPACING).x;
+      edit.highlightStart = m_CursorPosition;
+      edit.highlightBounds.x = MeasureRange(0, m_CursorPosition);
       break;
     case KEY_LEFT_CONTROL:
       break;
     case KEY_LEFT_SUPER:
       break;
+    case KEY_DOWN:
+    case KEY_UP:
+    case KEY_TAB:
+    case KEY_ENTER:
+    case KEY_ESCAPE:
+    {
+      // Enter only submits when there is no suggestion to accept
+      if (!m_Autocomplete || m_Autocomplete->GetSuggestions(this, m_InputText).empty())
+      {
+        if (key == KEY_ENTER)
+          m_PendingEvents |= 1 << GUI::EVENT_SUBMIT;
+        break;
+      }
+
+      const std::vector<std::string>& suggestions = m_Autocomplete->GetSuggestions(this, m_InputText);
+
+      if (key == KEY_DOWN)
+        edit.suggestionIndex = (edit.suggestionIndex+1)%suggestions.size();
+      else if (key == KEY_UP)
+        edit.suggestionIndex = (edit.suggestionIndex+suggestions.size()-1)%suggestions.size();
+      else if (key == KEY_ESCAPE)
+        m_Autocomplete->Cancel(this);
+      else
+        AcceptSuggestion(std::string(suggestions[edit.suggestionIndex < suggestions.size() ? edit.suggestionIndex : 0]));
+
+      // Tab went to the suggestion, so focus stays here
+      if (m_FocusManager)
+        m_FocusManager->ConsumeKey(key);
+      break;
+    }
     case KEY_LEFT:
-      if (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_LEFT_SUPER))
-        m_CursorPosition = FindLeftOf(m_InputText, ' ', m_CursorPosition);  
-      else if (m_CursorPosition)
-        m_CursorPosition--;
-      if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT))
+      if (KeyDown(m_FocusManager, KEY_LEFT_CONTROL) || KeyDown(m_FocusManager, KEY_LEFT_SUPER))
+        m_CursorPosition = edit.words.PreviousWordStart(m_CursorPosition);
+      else
+        m_CursorPosition = GUI::Utf8::PreviousCodepoint(m_InputText.c_str(), m_CursorPosition);
+      if (KeyDown(m_FocusManager, KEY_LEFT_SHIFT) || KeyDown(m_FocusManager, KEY_RIGHT_SHIFT))
       {
-        if (m_CursorPosition > m_HighlightStart)
+        if (m_CursorPosition > edit.highlightStart)
         {
-          m_HighlightBounds.y = MeasureTextEx(m_Style.font, m_InputText.substr(m_HighlightStart, m_CursorPosition-m_HighlightStart).c_str(), m_Style.fontSize, SPACING).x;
-          m_HighlightText = m_InputText.substr(m_HighlightStart, m_CursorPosition-m_HighlightStart); 
+          edit.highlightBounds.y = MeasureRange(edit.highlightStart, m_CursorPosition-edit.highlightStart);
+          edit.highlightText.assign(m_InputText, edit.highlightStart, m_CursorPosition-edit.highlightStart); 
           break;
         }
 
-        m_HighlightBounds.x = MeasureTextEx(m_Style.font, m_InputText.substr(0, m_CursorPosition).c_str(), m_Style.fontSize, SPACING).x+m_XOffset;
-        m_HighlightBounds.y = MeasureTextEx(m_Style.font, m_InputText.substr(m_CursorPosition, m_HighlightStart-m_CursorPosition).c_str(), m_Style.fontSize, SPACING).x;
-        m_HighlightText = m_InputText.substr(m_CursorPosition, m_HighlightStart-m_CursorPosition);
+        edit.highlightBounds.x = MeasureRange(0, m_CursorPosition)+m_XOffset;
+        edit.highlightBounds.y = MeasureRange(m_CursorPosition, edit.highlightStart-m_CursorPosition);
+        edit.highlightText.assign(m_InputText, m_CursorPosition, edit.highlightStart-m_CursorPosition);
       }
       else
       {
-        m_HighlightText = "";
-        m_HighlightBounds = { 0 };
+        edit.highlightText.clear();
+        edit.highlightBounds = { 0 };
       }
       break;
     case KEY_RIGHT:
     {
-      if (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_LEFT_SUPER))
-        m_CursorPosition = FindRightOf(m_InputText, ' ', m_CursorPosition);
-      else if (m_CursorPosition < m_InputText.length())
-        m_CursorPosition++;
-      if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT))
+      if (KeyDown(m_FocusManager, KEY_LEFT_CONTROL) || KeyDown(m_FocusManager, KEY_LEFT_SUPER))
+        m_CursorPosition = edit.words.NextWordEnd(m_CursorPosition);
+      else
+        m_CursorPosition = GUI::Utf8::NextCodepoint(m_InputText.c_str(), m_InputText.length(), m_CursorPosition);
+      if (KeyDown(m_FocusManager, KEY_LEFT_SHIFT) || KeyDown(m_FocusManager, KEY_RIGHT_SHIFT))
       {
-        if (m_CursorPosition < m_HighlightStart)
+        if (m_CursorPosition < edit.highlightStart)
         {
-          m_HighlightBounds.x = MeasureTextEx(m_Style.font, m_InputText.substr(0, m_CursorPosition).c_str(), m_Style.fontSize, SPACING).x;
-          m_HighlightBounds.y = MeasureTextEx(m_Style.font, m_InputText.substr(m_CursorPosition, m_HighlightStart-m_CursorPosition).c_str(), m_Style.fontSize, SPACING).x;
-          m_HighlightText = m_InputText.substr(m_CursorPosition, m_HighlightStart-m_CursorPosition);
+          edit.highlightBounds.x = MeasureRange(0, m_CursorPosition);
+          edit.highlightBounds.y = MeasureRange(m_CursorPosition, edit.highlightStart-m_CursorPosition);
+          edit.highlightText.assign(m_InputText, m_CursorPosition, edit.highlightStart-m_CursorPosition);
           break;
         }   
 
-        m_HighlightBounds.x = MeasureTextEx(m_Style.font, m_InputText.substr(0, m_HighlightStart).c_str(), m_Style.fontSize, SPACING).x+m_XOffset;
-        m_HighlightBounds.y = MeasureTextEx(m_Style.font, m_InputText.substr(m_HighlightStart, m_CursorPosition-m_HighlightStart).c_str(), m_Style.fontSize, SPACING).x;
-        m_HighlightText = m_InputText.substr(m_HighlightStart, m_CursorPosition-m_HighlightStart);
+        edit.highlightBounds.x = MeasureRange(0, edit.highlightStart)+m_XOffset;
+        edit.highlightBounds.y = MeasureRange(edit.highlightStart, m_CursorPosition-edit.highlightStart);
+        edit.highlightText.assign(m_InputText, edit.highlightStart, m_CursorPosition-edit.highlightStart);
       }
       else
       {
-        m_HighlightText = "";
-        m_HighlightBounds = { 0 };
+        edit.highlightText.clear();
+        edit.highlightBounds = { 0 };
       }
       break;
     }
     default:
-      if (IsKeyDown(KEY_LEFT_SHIFT))
+      if (KeyDown(m_FocusManager, KEY_LEFT_SHIFT))
       {
         if (key == KEY_LEFT_SHIFT)
           break;
 
-        if (key >= 'A' && key <= 'Z')
+        if (key == 'Z' && (KeyDown(m_FocusManager, KEY_LEFT_CONTROL) || KeyDown(m_FocusManager, KEY_LEFT_SUPER)))
         {
-          if (m_CursorPosition == m_InputText.length())
-          {
-            m_InputText += (char)key;
-            m_CursorPosition = m_InputText.length();
-          }
-          else
-          {
-            std::string toInput;
-            toInput += (char)key;
-            m_InputText.insert(m_CursorPosition, toInput);
-            m_CursorPosition++;
-          }
+          Redo();
         }
-        else if (key)
+        else if (typeCharacters && key >= 'A' && key <= 'Z')
+        {
+          char toInput = (char)key;
+          InsertText(&toInput, 1, true);
+        }
+        else if (typeCharacters && key)
         {
           std::string toInput;
           switch (key)
@@ -403,90 +800,212 @@ void GUI::Input::UpdateAndRender(GUI::MouseState& mouseState) noexcept
               break;
           }
 
-          if (m_CursorPosition == m_InputText.length())
-          {
-            m_InputText += toInput;
-            m_CursorPosition = m_InputText.length();
-          }
-          else
-          {
-            m_InputText.insert(m_CursorPosition, toInput);
-            m_CursorPosition++;
-          }
+          InsertText(toInput.c_str(), toInput.length(), true);
         }
       }
       else
       {
         if (key >= 'A' && key <= 'Z')
         {
-          if (key == 'C' && (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_LEFT_SUPER)))
+          if (key == 'C' && (KeyDown(m_FocusManager, KEY_LEFT_CONTROL) || KeyDown(m_FocusManager, KEY_LEFT_SUPER)))
           {
-            SetClipboardText(m_HighlightText.c_str());
+            SetClipboardText(edit.highlightText.c_str());
           }
-          else if (key == 'V' && (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_LEFT_SUPER)))
+          else if (key == 'V' && (KeyDown(m_FocusManager, KEY_LEFT_CONTROL) || KeyDown(m_FocusManager, KEY_LEFT_SUPER)))
           {
-            if (m_CursorPosition == m_InputText.length())
-            {
-              std::string clipboard = GetClipboardText();
-              ReplaceAll(clipboard, '\n', ' ');
-              m_InputText += clipboard;
-              m_CursorPosition += clipboard.length();
-            }
-            else
-            {
-              std::string clipboard = GetClipboardText();
-              m_InputText.insert(m_CursorPosition, clipboard);
-              m_CursorPosition += clipboard.length(); 
-            }
+            Paste(GetClipboardText());
           }
-          else if (m_CursorPosition == m_InputText.length())
+          else if (key == 'Z' && (KeyDown(m_FocusManager, KEY_LEFT_CONTROL) || KeyDown(m_FocusManager, KEY_LEFT_SUPER)))
           {
-            m_InputText += (char)(key+32);
-            m_CursorPosition = m_InputText.length();
+            Undo();
           }
-          else
+          else if (key == 'Y' && (KeyDown(m_FocusManager, KEY_LEFT_CONTROL) || KeyDown(m_FocusManager, KEY_LEFT_SUPER)))
+          {
+            Redo();
+          }
+          else if (typeCharacters)
           {
-            std::string toInput;
-            toInput += (char)(key+32);
-            m_InputText.insert(m_CursorPosition, toInput);
-            m_CursorPosition++;
+            char toInput = (char)(key+32);
+            InsertText(&toInput, 1, true);
           }
         }
-        else if (key)
+        else if (typeCharacters && key)
         {
           if (key == KEY_LEFT_CONTROL || key == KEY_LEFT_SUPER)
             break;
 
-          if (m_CursorPosition == m_InputText.length())
-          {
-            m_InputText += (char)key;
-            m_CursorPosition = m_InputText.length();
-          }
-          else
-          {
-            std::string toInput;
-            toInput += (char)key;
-            m_InputText.insert(m_CursorPosition, toInput);
-            m_CursorPosition++;
-          }
+          char toInput = (char)key;
+          InsertText(&toInput, 1, true);
         }
       }
   }
+}
+
+void GUI::Input::UpdateAndRender(GUI::MouseState& mouseState) noexcept
+{
+  bool wasSelected = m_Selected;
+  if (mouseState.focus && m_FocusManager != mouseState.focus)
+  {
+    if (m_FocusManager)
+      m_FocusManager->Unregister(this);
+
+    m_FocusManager = mouseState.focus;
+    m_FocusManager->Register(this);
+    if (m_Selected)
+      m_FocusManager->SetFocus(this);
+  }
+
+  if (m_FocusManager)
+    m_Selected = m_FocusManager->HasFocus(this);
+
+  bool hovered = CheckCollisionPointRec(mouseState.position, m_Bounds);
+  if (hovered)
+  {
+    mouseState.cursor = MOUSE_CURSOR_IBEAM;
+
+    if (!mouseState.clicked && mouseState.pressed)
+    {
+      double now = Seconds();
+      if (m_Selected && now-Edit().lastClickTime < 0.3)
+        SelectWordAt(GUI::Text::IndexAtX(GetStyle().font, m_InputText.c_str(), m_InputText.length(), GetStyle().fontSize, SPACING, mouseState.position.x-m_Bounds.x-5-m_XOffset));
+
+      Edit().lastClickTime = now;
+      m_Selected = true;
+      mouseState.clicked = true;
+      if (m_FocusManager)
+        m_FocusManager->SetFocus(this);
+    }
+  }
+
+  if (hovered != m_Hovered)
+    m_PendingEvents |= 1 << (hovered ? GUI::EVENT_HOVER_ENTER : GUI::EVENT_HOVER_LEAVE);
+  if (m_Selected != wasSelected)
+    m_PendingEvents |= 1 << (m_Selected ? GUI::EVENT_FOCUS : GUI::EVENT_BLUR);
+  m_Hovered = hovered;
+
+  UpdateTransition(mouseState, m_HoverProgress, hovered ? 1.0f : 0.0f);
+  UpdateTransition(mouseState, m_SelectProgress, m_Selected ? 1.0f : 0.0f);
+
+  Color backgroundColor = GUI::LerpColor(GUI::LerpColor(GetStyle().baseBackgroundColor, GetStyle().hoverBackgroundColor, m_HoverProgress), GetStyle().selectedBackgroundColor, m_SelectProgress);
+  Color outlineColor = GUI::LerpColor(GUI::LerpColor(GetStyle().baseOutlineColor, GetStyle().hoverOutlineColor, m_HoverProgress), GetStyle().selectedOutlineColor, m_SelectProgress);
+  Color textColor = GUI::LerpColor(GUI::LerpColor(GetStyle().baseTextColor, GetStyle().hoverTextColor, m_HoverProgress), GetStyle().selectedTextColor, m_SelectProgress);
 
-  if (m_HighlightText.length())
+  Color invalidOutlineColor = GUI::ResolveColor(GetStyle().invalidOutlineColor);
+  if (invalidOutlineColor.a && m_InputText.length() && GetValidationState() != GUI::VALIDATION_STATE_VALID)
+    outlineColor = invalidOutlineColor;
+
+  GUI::TileRenderer* tiles = mouseState.tiles;
+  Rectangle outlineBounds = { m_Bounds.x-GetStyle().outlineDistance, m_Bounds.y-GetStyle().outlineDistance, m_Bounds.width+GetStyle().outlineDistance*2, m_Bounds.height+GetStyle().outlineDistance*2 };
+  if (tiles)
   {
-    if (m_Bounds.x+m_HighlightBounds.x+m_HighlightBounds.y > m_Bounds.x+m_Bounds.width)
-      m_HighlightBounds.y -= (m_Bounds.x+m_HighlightBounds.x+m_HighlightBounds.y)-(m_Bounds.x+m_Bounds.width)+10;
-    DrawRectangle(m_Bounds.x+m_HighlightBounds.x+5, m_Bounds.y+3, m_HighlightBounds.y+5, m_Bounds.height-6, m_Style.highlightColor);
+    if (GetStyle().outlineFill)
+      tiles->DrawRectangleRounded(outlineBounds, GetStyle().roundness, outlineColor);
+    else
+      tiles->DrawRectangleRoundedLines(outlineBounds, GetStyle().roundness, GetStyle().outlineThickness, outlineColor);
+
+    tiles->DrawRectangleRounded(m_Bounds, GetStyle().roundness, backgroundColor);
+  }
+  else
+  {
+    if (GetStyle().outlineFill)
+      DrawRectangleRounded(outlineBounds, GetStyle().roundness, SEGMENTS, outlineColor);
+    else
+      DrawRectangleRoundedLines(outlineBounds, GetStyle().roundness, SEGMENTS, GetStyle().outlineThickness, outlineColor);
+
+    DrawRectangleRounded(m_Bounds, GetStyle().roundness, SEGMENTS, backgroundColor);
+  }
+
+  if (!m_InputText.length() && !m_Selected)
+  {
+    Vector2 placeholderPosition = { m_Bounds.x+5, m_Bounds.y+(m_Bounds.height/2)-(GetStyle().fontSize/2) };
+    if (m_PlaceholderText && tiles)
+      tiles->DrawTextEx(tiles->GetFontAtlas(GetStyle().font), GetStyle().font, m_PlaceholderText->c_str(), placeholderPosition, GetStyle().fontSize, SPACING, textColor);
+    else if (m_PlaceholderText && mouseState.textBatcher)
+      mouseState.textBatcher->AddText(GetStyle().font, m_PlaceholderText->c_str(), placeholderPosition, GetStyle().fontSize, SPACING, textColor);
+    else if (m_PlaceholderText)
+      DrawTextEx(GetStyle().font, m_PlaceholderText->c_str(), placeholderPosition, GetStyle().fontSize, SPACING, textColor);
+    PushEvents(mouseState);
+    return;
+  }
+
+  // Unfocused inputs do no keyboard work at all, a held key keeps the host from sleeping through its repeats
+  if (m_Selected && HandleKeyboard() && mouseState.animator)
+    mouseState.animator->RequestFrame();
+  PushEvents(mouseState);
+
+  if (m_Edit && m_Edit->highlightText.length())
+  {
+    Vector2& highlightBounds = m_Edit->highlightBounds;
+    if (m_Bounds.x+highlightBounds.x+highlightBounds.y > m_Bounds.x+m_Bounds.width)
+      highlightBounds.y -= (m_Bounds.x+highlightBounds.x+highlightBounds.y)-(m_Bounds.x+m_Bounds.width)+10;
+    if (tiles)
+      tiles->DrawRectangle(PixelRect(m_Bounds.x+highlightBounds.x+5, m_Bounds.y+3, highlightBounds.y+5, m_Bounds.height-6), GUI::ResolveColor(GetStyle().highlightColor));
+    else
+      DrawRectangle(m_Bounds.x+highlightBounds.x+5, m_Bounds.y+3, highlightBounds.y+5, m_Bounds.height-6, GUI::ResolveColor(GetStyle().highlightColor));
   }
 
   if (m_Selected)
   {
     UpdateCursorPosition(mouseState);
-    DrawCursor();
+    DrawCursor(tiles);
+  }
+
+  // Clipped on the CPU so the text of every input can share one batch
+  GUI::ClipStack localClip;
+  GUI::ClipStack& clip = mouseState.clip ? *mouseState.clip : localClip;
+  clip.Push({ m_Bounds.x+5, m_Bounds.y, m_Bounds.width-10, m_Bounds.height });
+  Vector2 textPosition = { m_Bounds.x+5+m_XOffset, m_Bounds.y+(m_Bounds.height/2)-(GetStyle().fontSize/2) };
+  if (tiles)
+  {
+    Rectangle textClip = clip.GetRect();
+    tiles->DrawTextEx(tiles->GetFontAtlas(GetStyle().font), GetStyle().font, m_InputText.c_str(), textPosition, GetStyle().fontSize, SPACING, textColor, &textClip);
   }
+  else if (mouseState.textBatcher)
+    mouseState.textBatcher->AddText(GetStyle().font, m_InputText.c_str(), textPosition, GetStyle().fontSize, SPACING, textColor, &clip);
+  else
+    clip.DrawTextEx(GetStyle().font, m_InputText.c_str(), textPosition, GetStyle().fontSize, SPACING, textColor);
+  clip.Pop();
+
+  if (m_Selected && m_Autocomplete)
+    DrawSuggestions(mouseState);
+}
+
+void GUI::Input::DrawToTiles(GUI::TileRenderer& tiles)
+{
+  // The resting, unfocused state on the CPU, matching UpdateAndRender without hover or selection
+  const GUI::InputStyle& style = GetStyle();
+  Color outlineColor = GUI::ResolveColor(style.baseOutlineColor);
+  Color textColor = GUI::ResolveColor(style.baseTextColor);
+
+  Color invalidOutlineColor = GUI::ResolveColor(style.invalidOutlineColor);
+  if (invalidOutlineColor.a && m_InputText.length() && GetValidationState() != GUI::VALIDATION_STATE_VALID)
+    outlineColor = invalidOutlineColor;
+
+  Rectangle outlineBounds = { m_Bounds.x-style.outlineDistance, m_Bounds.y-style.outlineDistance, m_Bounds.width+style.outlineDistance*2, m_Bounds.height+style.outlineDistance*2 };
+  if (style.outlineFill)
+    tiles.DrawRectangleRounded(outlineBounds, style.roundness, outlineColor);
+  else
+    tiles.DrawRectangleRoundedLines(outlineBounds, style.roundness, style.outlineThickness, outlineColor);
 
-  BeginScissorMode(m_Bounds.x+5, m_Bounds.y+(m_Bounds.height/2)-5, m_Bounds.width-5, m_Bounds.height);
-  DrawTextEx(m_Style.font, m_InputText.c_str(), { m_Bounds.x+5+m_XOffset, m_Bounds.y+(m_Bounds.height/2)-(m_Style.fontSize/2) }, m_Style.fontSize, SPACING, textColor);
-  EndScissorMode();
+  tiles.DrawRectangleRounded(m_Bounds, style.roundness, GUI::ResolveColor(style.baseBackgroundColor));
+
+  Vector2 textPosition = { m_Bounds.x+5+m_XOffset, m_Bounds.y+(m_Bounds.height/2)-(style.fontSize/2) };
+  Rectangle clip = { m_Bounds.x+5, m_Bounds.y, m_Bounds.width-10, m_Bounds.height };
+  const Image& atlas = tiles.GetFontAtlas(style.font);
+  if (m_InputText.length())
+    tiles.DrawTextEx(atlas, style.font, m_InputText.c_str(), textPosition, style.fontSize, SPACING, textColor, &clip);
+  else if (m_PlaceholderText)
+    tiles.DrawTextEx(atlas, style.font, m_PlaceholderText->c_str(), { m_Bounds.x+5, textPosition.y }, style.fontSize, SPACING, textColor);
+}
+
+void GUI::Input::ReportMemory(GUI::MemoryReport& report) const
+{
+  size_t bytes = sizeof(GUI::Input)+HeapBytes(m_InputText)+m_Checkpoints.capacity()*sizeof(uint16_t);
+  if (m_PlaceholderText)
+    bytes += sizeof(std::string)+HeapBytes(*m_PlaceholderText);
+  if (m_Edit)
+    bytes += sizeof(GUI::InputEditState)+HeapBytes(m_Edit->highlightText)+m_Edit->journal.GetMemoryUsage()+m_Edit->words.GetMemoryUsage();
+
+  report.Add("widget", "Input", bytes);
+  report.Add("by style", "Input #"+std::to_string(m_Style), bytes);
 }
@@ -0,0 +1,274 @@
+#include "../../include/gui.hpp"
+
+#include <string.h>
+
+static constexpr size_t NO_RECORD = SIZE_MAX;
+
+static size_t RecordSize(size_t length) noexcept
+{
+  // Records stay aligned so every header is read in place
+  constexpr size_t align = alignof(GUI::EditDelta);
+  return (sizeof(GUI::EditDelta)+length+align-1)/align*align;
+}
+
+GUI::EditJournal::EditJournal(void)
+  : EditJournal(64*1024)
+{ }
+
+GUI::EditJournal::EditJournal(size_t maxBytes)
+  : m_Head(0), m_Last(NO_RECORD), m_MaxBytes(maxBytes), m_Sealed(true), m_Joining(false)
+{ }
+
+GUI::EditDelta& GUI::EditJournal::At(size_t position) noexcept
+{
+  return *reinterpret_cast<GUI::EditDelta*>(m_Buffer.data()+position);
+}
+
+char* GUI::EditJournal::Data(size_t position) noexcept
+{
+  return m_Buffer.data()+position+sizeof(GUI::EditDelta);
+}
+
+bool GUI::EditJournal::BeginRecord(size_t length) noexcept
+{
+  // An edit that can never fit would leave older deltas pointing at the wrong offsets
+  if (RecordSize(length) > m_MaxBytes)
+  {
+    Clear();
+    return false;
+  }
+
+  DropRedo();
+  return true;
+}
+
+void GUI::EditJournal::DropRedo(void) noexcept
+{
+  if (m_Head < m_Buffer.size())
+  {
+    m_Buffer.resize(m_Head);
+    m_Sealed = true;
+  }
+}
+
+void GUI::EditJournal::Trim(size_t needed, size_t keep) noexcept
+{
+  // Drops the oldest records in one pass until needed more bytes fit, the record at keep and later ones stay
+  size_t drop = 0;
+  while (drop < keep && m_Buffer.size()-drop+needed > m_MaxBytes)
+    drop += RecordSize(At(drop).length);
+
+  if (!drop)
+    return;
+
+  m_Buffer.erase(m_Buffer.begin(), m_Buffer.begin()+drop);
+
+  size_t previous = NO_RECORD;
+  for (size_t position = 0; position < m_Buffer.size(); position += RecordSize(At(position).length))
+  {
+    At(position).previous = previous;
+    previous = position;
+  }
+
+  // The rest of a joined step cannot be undone without the part that was dropped
+  if (!m_Buffer.empty())
+    At(0).joined = false;
+
+  m_Last = previous;
+  m_Head = m_Buffer.size();
+}
+
+void GUI::EditJournal::Resize(size_t size) noexcept
+{
+  // Capacity doubles up to the budget and stops there, so a journal at its cap records without allocating
+  if (size > m_Buffer.capacity())
+  {
+    size_t capacity = m_Buffer.capacity() ? m_Buffer.capacity()*2 : 256;
+    if (capacity < size)
+      capacity = size;
+    if (capacity > m_MaxBytes)
+      capacity = m_MaxBytes > size ? m_MaxBytes : size;
+    m_Buffer.reserve(capacity);
+  }
+
+  m_Buffer.resize(size);
+}
+
+void GUI::EditJournal::Append(size_t offset, const char* bytes, size_t length, size_t cursor, bool insert, bool coalesce) noexcept
+{
+  Trim(RecordSize(length), m_Buffer.size());
+
+  size_t position = m_Buffer.size();
+  Resize(position+RecordSize(length));
+  At(position) = { offset, length, cursor, m_Last, insert, m_Joining && m_Last != NO_RECORD };
+  memcpy(Data(position), bytes, length);
+
+  m_Last = position;
+  m_Head = m_Buffer.size();
+  m_Sealed = !coalesce;
+  m_Joining = false;
+}
+
+void GUI::EditJournal::Extend(size_t length) noexcept
+{
+  // Grows the newest record in place, the older ones make room for it
+  size_t size = RecordSize(At(m_Last).length);
+  Trim(RecordSize(At(m_Last).length+length)-size, m_Last);
+  Resize(m_Last+RecordSize(At(m_Last).length+length));
+  m_Head = m_Buffer.size();
+}
+
+void GUI::EditJournal::RecordInsert(size_t offset, const char* bytes, size_t length, size_t cursor, bool coalesce) noexcept
+{
+  if (!length || !BeginRecord(length))
+    return;
+
+  // A run that would outgrow the whole budget is cut into a new record instead
+  if (coalesce && !m_Sealed && m_Last != NO_RECORD && RecordSize(At(m_Last).length+length) > m_MaxBytes)
+    m_Sealed = true;
+
+  if (coalesce && !m_Sealed && m_Last != NO_RECORD)
+  {
+    const GUI::EditDelta& last = At(m_Last);
+    bool wordStart = bytes[0] != ' ' && Data(m_Last)[last.length-1] == ' ';
+
+    if (last.insert && last.offset+last.length == offset && !wordStart)
+    {
+      Extend(length);
+      GUI::EditDelta& grown = At(m_Last);
+      memcpy(Data(m_Last)+grown.length, bytes, length);
+      grown.length += length;
+      return;
+    }
+  }
+
+  Append(offset, bytes, length, cursor, true, coalesce);
+}
+
+void GUI::EditJournal::RecordErase(size_t offset, const char* bytes, size_t length, size_t cursor, bool coalesce) noexcept
+{
+  if (!length || !BeginRecord(length))
+    return;
+
+  if (coalesce && !m_Sealed && m_Last != NO_RECORD && RecordSize(At(m_Last).length+length) > m_MaxBytes)
+    m_Sealed = true;
+
+  if (coalesce && !m_Sealed && m_Last != NO_RECORD)
+  {
+    const GUI::EditDelta& last = At(m_Last);
+
+    if (!last.insert && offset+length == last.offset)
+    {
+      // Backspacing, the new bytes come before the ones already recorded
+      Extend(length);
+      GUI::EditDelta& grown = At(m_Last);
+      memmove(Data(m_Last)+length, Data(m_Last), grown.length);
+      memcpy(Data(m_Last), bytes, length);
+      grown.offset = offset;
+      grown.length += length;
+      return;
+    }
+
+    if (!last.insert && offset == last.offset)
+    {
+      Extend(length);
+      GUI::EditDelta& grown = At(m_Last);
+      memcpy(Data(m_Last)+grown.length, bytes, length);
+      grown.length += length;
+      return;
+    }
+  }
+
+  Append(offset, bytes, length, cursor, false, coalesce);
+}
+
+void GUI::EditJournal::Seal(void) noexcept
+{
+  m_Sealed = true;
+  m_Joining = false;
+}
+
+void GUI::EditJournal::Join(void) noexcept
+{
+  m_Sealed = true;
+  m_Joining = true;
+}
+
+bool GUI::EditJournal::Undo(std::string& text, size_t& cursor) noexcept
+{
+  if (m_Last == NO_RECORD)
+    return false;
+
+  // A joined delta goes back together with the one before it
+  bool joined;
+  do
+  {
+    const GUI::EditDelta& delta = At(m_Last);
+    if (delta.insert)
+      text.erase(delta.offset, delta.length);
+    else
+      text.insert(delta.offset, Data(m_Last), delta.length);
+
+    cursor = delta.cursor;
+    joined = delta.joined;
+    m_Head = m_Last;
+    m_Last = delta.previous;
+  } while (joined && m_Last != NO_RECORD);
+
+  m_Sealed = true;
+  m_Joining = false;
+  return true;
+}
+
+bool GUI::EditJournal::Redo(std::string& text, size_t& cursor) noexcept
+{
+  if (m_Head == m_Buffer.size())
+    return false;
+
+  do
+  {
+    const GUI::EditDelta& delta = At(m_Head);
+    if (delta.insert)
+    {
+      text.insert(delta.offset, Data(m_Head), delta.length);
+      cursor = delta.offset+delta.length;
+    }
+    else
+    {
+      text.erase(delta.offset, delta.length);
+      cursor = delta.offset;
+    }
+
+    m_Last = m_Head;
+    m_Head += RecordSize(delta.length);
+  } while (m_Head < m_Buffer.size() && At(m_Head).joined);
+
+  m_Sealed = true;
+  m_Joining = false;
+  return true;
+}
+
+void GUI::EditJournal::Clear(void) noexcept
+{
+  m_Buffer.clear();
+  m_Head = 0;
+  m_Last = NO_RECORD;
+  m_Sealed = true;
+  m_Joining = false;
+}
+
+void GUI::EditJournal::SetMaxBytes(size_t maxBytes) noexcept
+{
+  m_MaxBytes = maxBytes;
+  if (m_Buffer.size() <= m_MaxBytes)
+    return;
+
+  // Undone edits go first, then the oldest ones, the newest is always kept
+  DropRedo();
+  Trim(0, m_Last);
+}
+
+size_t GUI::EditJournal::GetMemoryUsage(void) const noexcept
+{
+  return m_Buffer.capacity();
+}
@@ -0,0 +1,191 @@
+#include "../../include/gui.hpp"
+
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static uint32_t HashId(const char* id) noexcept
+{
+  // Same FNV-1a as tools/guic and top-level GUI::ImContext ids
+  uint32_t hash = 2166136261u;
+  for (; *id; id++)
+    hash = (hash ^ (unsigned char)*id)*16777619u;
+
+  return hash ? hash : 1;
+}
+
+GUI::Layout::Layout(void)
+  : m_Data(nullptr), m_Size(0), m_Mapped(false)
+{ }
+
+GUI::Layout::~Layout(void)
+{
+  Unload();
+}
+
+bool GUI::Layout::Load(const char* fileName) noexcept
+{
+  Unload();
+
+#if !defined(_WIN32)
+  int file = open(fileName, O_RDONLY);
+  if (file < 0)
+  {
+    TraceLog(LOG_WARNING, "GUI: Failed to open layout \"%s\"", fileName);
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(file, &info) == 0 && info.st_size > 0)
+  {
+    void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (data != MAP_FAILED)
+    {
+      m_Data = (const unsigned char*)data;
+      m_Size = info.st_size;
+      m_Mapped = true;
+    }
+  }
+  close(file);
+#else
+  // windows.h clashes with raylib, so the file is read into a single buffer there instead
+  unsigned int size = 0;
+  m_Data = LoadFileData(fileName, &size);
+  m_Size = size;
+#endif
+
+  if (!m_Data || !Validate())
+  {
+    TraceLog(LOG_WARNING, "GUI: \"%s\" is not a valid compiled layout", fileName);
+    Unload();
+    return false;
+  }
+
+  return true;
+}
+
+void GUI::Layout::Unload(void) noexcept
+{
+  if (!m_Data)
+    return;
+
+#if !defined(_WIN32)
+  if (m_Mapped)
+    munmap((void*)m_Data, m_Size);
+#else
+  UnloadFileData((unsigned char*)m_Data);
+#endif
+
+  m_Data = nullptr;
+  m_Size = 0;
+  m_Mapped = false;
+}
+
+const GUI::LayoutHeader& GUI::Layout::GetHeader(void) const noexcept
+{
+  return *(const GUI::LayoutHeader*)m_Data;
+}
+
+bool GUI::Layout::Validate(void) const noexcept
+{
+  // Checked once at load so every accessor can index the mapping directly
+  if (m_Size < sizeof(GUI::LayoutHeader))
+    return false;
+
+  const GUI::LayoutHeader& header = GetHeader();
+  if (memcmp(header.magic, "GUIB", 4) || header.version != LAYOUT_VERSION)
+    return false;
+
+  if (header.widgetOffset % 4 || header.styleOffset % 4 || header.lookupOffset % 4)
+    return false;
+  if (header.widgetOffset > m_Size || header.widgetCount > (m_Size-header.widgetOffset)/sizeof(GUI::LayoutWidget))
+    return false;
+  if (header.styleOffset > m_Size || header.styleCount > (m_Size-header.styleOffset)/sizeof(uint32_t))
+    return false;
+  if (header.lookupOffset > m_Size || header.lookupCapacity > (m_Size-header.lookupOffset)/sizeof(GUI::LayoutLookup))
+    return false;
+  if (header.lookupCapacity & (header.lookupCapacity-1))
+    return false;
+  if (!header.stringSize || header.stringOffset > m_Size || header.stringSize > m_Size-header.stringOffset || m_Data[header.stringOffset+header.stringSize-1])
+    return false;
+
+  const GUI::LayoutWidget* widgets = GetWidgets();
+  for (uint32_t i = 0; i < header.widgetCount; i++)
+  {
+    const GUI::LayoutWidget& widget = widgets[i];
+    if (widget.id >= header.stringSize || widget.text >= header.stringSize || widget.style >= header.styleCount)
+      return false;
+    if (widget.next <= i || widget.next > header.widgetCount || (widget.parent != LAYOUT_NO_PARENT && widget.parent >= i))
+      return false;
+  }
+
+  const uint32_t* styles = (const uint32_t*)(m_Data+header.styleOffset);
+  for (uint32_t i = 0; i < header.styleCount; i++)
+  {
+    if (styles[i] >= header.stringSize)
+      return false;
+  }
+
+  const GUI::LayoutLookup* lookups = (const GUI::LayoutLookup*)(m_Data+header.lookupOffset);
+  for (uint32_t i = 0; i < header.lookupCapacity; i++)
+  {
+    if (lookups[i].hash && lookups[i].widget >= header.widgetCount)
+      return false;
+  }
+
+  return true;
+}
+
+size_t GUI::Layout::GetWidgetCount(void) const noexcept
+{
+  return m_Data ? GetHeader().widgetCount : 0;
+}
+
+const GUI::LayoutWidget* GUI::Layout::GetWidgets(void) const noexcept
+{
+  return m_Data ? (const GUI::LayoutWidget*)(m_Data+GetHeader().widgetOffset) : nullptr;
+}
+
+const GUI::LayoutWidget* GUI::Layout::Find(const char* id) const noexcept
+{
+  if (!m_Data || !GetHeader().lookupCapacity)
+    return nullptr;
+
+  // The compiler lays out an open-addressing table, so lookups need no index built at load
+  const GUI::LayoutHeader& header = GetHeader();
+  const GUI::LayoutLookup* lookups = (const GUI::LayoutLookup*)(m_Data+header.lookupOffset);
+  uint32_t hash = HashId(id);
+  uint32_t mask = header.lookupCapacity-1;
+
+  for (uint32_t i = hash & mask, probes = 0; lookups[i].hash && probes < header.lookupCapacity; i = (i+1) & mask, probes++)
+  {
+    const GUI::LayoutWidget& widget = GetWidgets()[lookups[i].widget];
+    if (lookups[i].hash == hash && !strcmp(GetString(widget.id), id))
+      return &widget;
+  }
+
+  return nullptr;
+}
+
+const char* GUI::Layout::GetString(uint32_t offset) const noexcept
+{
+  return m_Data && offset < GetHeader().stringSize ? (const char*)m_Data+GetHeader().stringOffset+offset : "";
+}
+
+size_t GUI::Layout::GetStyleCount(void) const noexcept
+{
+  return m_Data ? GetHeader().styleCount : 0;
+}
+
+const char* GUI::Layout::GetStyleName(uint16_t style) const noexcept
+{
+  if (style >= GetStyleCount())
+    return "";
+
+  return GetString(((const uint32_t*)(m_Data+GetHeader().styleOffset))[style]);
+}
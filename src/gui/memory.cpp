@@ -0,0 +1,62 @@
+#include "../../include/gui.hpp"
+
+GUI::MemoryReport::MemoryReport(void)
+  : m_LastEntry(0)
+{ }
+
+void GUI::MemoryReport::Add(const char* category, const std::string& name, size_t bytes, size_t count)
+{
+  // Reports are filled widget by widget, so consecutive calls nearly always hit the same entry
+  if (m_LastEntry >= m_Entries.size() || m_Entries[m_LastEntry].name != name || m_Entries[m_LastEntry].category != category)
+  {
+    m_LastEntry = 0;
+    while (m_LastEntry < m_Entries.size() && (m_Entries[m_LastEntry].name != name || m_Entries[m_LastEntry].category != category))
+      m_LastEntry++;
+
+    if (m_LastEntry == m_Entries.size())
+      m_Entries.push_back({ category, name, 0, 0 });
+  }
+
+  m_Entries[m_LastEntry].count += count;
+  m_Entries[m_LastEntry].bytes += bytes;
+}
+
+void GUI::MemoryReport::Clear(void) noexcept
+{
+  m_Entries.clear();
+  m_LastEntry = 0;
+}
+
+const std::vector<GUI::MemoryEntry>& GUI::MemoryReport::GetEntries(void) const noexcept
+{
+  return m_Entries;
+}
+
+size_t GUI::MemoryReport::GetTotal(void) const noexcept
+{
+  size_t total = 0;
+  for (const GUI::MemoryEntry& entry : m_Entries)
+    total += entry.bytes;
+
+  return total;
+}
+
+size_t GUI::MemoryReport::GetTotal(const char* category) const noexcept
+{
+  size_t total = 0;
+  for (const GUI::MemoryEntry& entry : m_Entries)
+  {
+    if (entry.category == category)
+      total += entry.bytes;
+  }
+
+  return total;
+}
+
+void GUI::MemoryReport::Log(void) const
+{
+  for (const GUI::MemoryEntry& entry : m_Entries)
+    TraceLog(LOG_INFO, "GUI: %-8s %-24s %8zu x %10zu bytes", entry.category.c_str(), entry.name.c_str(), entry.count, entry.bytes);
+
+  TraceLog(LOG_INFO, "GUI: %zu bytes total", GetTotal());
+}
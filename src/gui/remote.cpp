@@ -0,0 +1,784 @@
+#include "../../include/gui.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+
+#if !defined(_WIN32)
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  // A viewer that is this far behind skips frames, its dirty tiles are sent from the newest frame once it catches up
+  constexpr size_t MAX_PENDING_BYTES = 4*1024*1024;
+  // Viewers only send small input messages
+  constexpr uint32_t MAX_INPUT_MESSAGE = 64;
+
+#if !defined(MSG_NOSIGNAL)
+  constexpr int MSG_NOSIGNAL = 0;
+#endif
+}
+
+static float Milliseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) noexcept
+{
+  return std::chrono::duration<float, std::milli>(end-start).count();
+}
+
+static void AppendMessage(std::string& buffer, GUI::RemoteMessageTypes type, const void* payload, uint32_t size)
+{
+  GUI::RemoteMessage message = GUI::RemoteMessage();
+  message.type = type;
+  message.size = size;
+  buffer.append((const char*)&message, sizeof(message));
+  buffer.append((const char*)payload, size);
+}
+
+// PackBits over whole pixels, UI frames are mostly flat fills with short runs of antialiased edges in between
+static void EncodePixels(const uint32_t* pixels, size_t count, std::string& output)
+{
+  size_t i = 0;
+  while (i < count)
+  {
+    size_t run = 1;
+    while (i+run < count && run < 129 && pixels[i+run] == pixels[i])
+      run++;
+
+    if (run >= 2)
+    {
+      output.push_back((char)(run+126));
+      output.append((const char*)&pixels[i], 4);
+      i += run;
+      continue;
+    }
+
+    // Literals stop where the next run of two starts
+    size_t literal = 1;
+    while (i+literal < count && literal < 128 && !(i+literal+1 < count && pixels[i+literal] == pixels[i+literal+1]))
+      literal++;
+
+    output.push_back((char)(literal-1));
+    output.append((const char*)&pixels[i], literal*4);
+    i += literal;
+  }
+}
+
+static bool DecodePixels(const unsigned char* data, size_t size, uint32_t* pixels, size_t count) noexcept
+{
+  size_t i = 0;
+  const unsigned char* end = data+size;
+  while (data < end)
+  {
+    unsigned char control = *data++;
+    if (control < 128)
+    {
+      size_t literal = (size_t)control+1;
+      if (i+literal > count || (size_t)(end-data) < literal*4)
+        return false;
+
+      memcpy(&pixels[i], data, literal*4);
+      data += literal*4;
+      i += literal;
+    }
+    else
+    {
+      size_t run = (size_t)control-126;
+      if (i+run > count || end-data < 4)
+        return false;
+
+      uint32_t pixel;
+      memcpy(&pixel, data, 4);
+      data += 4;
+      for (size_t j = 0; j < run; j++)
+        pixels[i++] = pixel;
+    }
+  }
+
+  return i == count;
+}
+
+#if !defined(_WIN32)
+// Opens a stream socket for "unix:<path>" or "[host:]port", bound when listening and connected otherwise
+static int OpenSocket(const char* address, bool listening, std::string& path) noexcept
+{
+  path.clear();
+  if (!strncmp(address, "unix:", 5))
+  {
+    sockaddr_un local = sockaddr_un();
+    local.sun_family = AF_UNIX;
+    if (strlen(address+5) >= sizeof(local.sun_path))
+      return -1;
+    strcpy(local.sun_path, address+5);
+
+    int socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket < 0)
+      return -1;
+
+    // A socket file left behind by a crashed server would make bind fail
+    if (listening)
+      unlink(local.sun_path);
+
+    if (listening ? bind(socket, (sockaddr*)&local, sizeof(local)) || listen(socket, 8) : connect(socket, (sockaddr*)&local, sizeof(local)))
+    {
+      close(socket);
+      return -1;
+    }
+
+    if (listening)
+      path = local.sun_path;
+    return socket;
+  }
+
+  std::string host = "127.0.0.1";
+  const char* port = strrchr(address, ':');
+  if (port)
+    host.assign(address, port-address);
+  port = port ? port+1 : address;
+
+  addrinfo hints = addrinfo();
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = listening ? AI_PASSIVE : 0;
+
+  addrinfo* addresses;
+  if (getaddrinfo(host.c_str(), port, &hints, &addresses))
+    return -1;
+
+  int socket = -1;
+  for (addrinfo* entry = addresses; entry && socket < 0; entry = entry->ai_next)
+  {
+    socket = ::socket(entry->ai_family, entry->ai_socktype, entry->ai_protocol);
+    if (socket < 0)
+      continue;
+
+    int enable = 1;
+    if (listening)
+      setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    if (listening ? bind(socket, entry->ai_addr, entry->ai_addrlen) || listen(socket, 8) : connect(socket, entry->ai_addr, entry->ai_addrlen))
+    {
+      close(socket);
+      socket = -1;
+    }
+  }
+
+  freeaddrinfo(addresses);
+  return socket;
+}
+
+static void PrepareSocket(int socket) noexcept
+{
+  fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK);
+
+  // Input events are tiny and should not wait for more data, fails harmlessly on Unix sockets
+  int enable = 1;
+  setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+#if defined(SO_NOSIGPIPE)
+  setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+}
+
+// Moves what the socket has into the buffer, false once the peer is gone
+static bool ReadSocket(int socket, std::string& buffer, size_t& received) noexcept
+{
+  char chunk[16*1024];
+  for (;;)
+  {
+    ssize_t size = recv(socket, chunk, sizeof(chunk), 0);
+    if (size > 0)
+    {
+      buffer.append(chunk, size);
+      received += size;
+      continue;
+    }
+
+    if (size < 0 && errno == EINTR)
+      continue;
+    return size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+  }
+}
+
+// Sends as much of the buffer as the socket takes, false once the peer is gone
+static bool WriteSocket(int socket, const std::string& buffer, size_t& offset) noexcept
+{
+  while (offset < buffer.size())
+  {
+    ssize_t size = send(socket, buffer.data()+offset, buffer.size()-offset, MSG_NOSIGNAL);
+    if (size > 0)
+    {
+      offset += size;
+      continue;
+    }
+
+    if (size < 0 && errno == EINTR)
+      continue;
+    return size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+  }
+
+  return true;
+}
+#endif
+
+GUI::RemoteServer::RemoteServer(void)
+  : RemoteServer(GUI::SOFTWARE_TILE_SIZE)
+{ }
+
+GUI::RemoteServer::RemoteServer(int tileSize)
+  : m_Socket(-1), m_TileSize(tileSize > 0 && tileSize <= UINT16_MAX ? tileSize : GUI::SOFTWARE_TILE_SIZE), m_Width(0), m_Height(0), m_Columns(0), m_Rows(0), m_Focus(nullptr), m_MousePosition(), m_MousePressed(false), m_MouseDown(false), m_Stats()
+{ }
+
+GUI::RemoteServer::~RemoteServer(void)
+{
+  Close();
+}
+
+bool GUI::RemoteServer::Listen(const char* address) noexcept
+{
+  Close();
+
+#if !defined(_WIN32)
+  m_Socket = OpenSocket(address, true, m_Path);
+  if (m_Socket < 0)
+  {
+    TraceLog(LOG_WARNING, "GUI: Failed to listen on \"%s\"", address);
+    return false;
+  }
+
+  fcntl(m_Socket, F_SETFL, fcntl(m_Socket, F_GETFL, 0) | O_NONBLOCK);
+  return true;
+#else
+  // winsock2.h clashes with raylib like windows.h does
+  TraceLog(LOG_WARNING, "GUI: Remote streaming is not supported on Windows, cannot listen on \"%s\"", address);
+  return false;
+#endif
+}
+
+void GUI::RemoteServer::Close(void) noexcept
+{
+  while (!m_Clients.empty())
+    Disconnect(m_Clients.size()-1);
+
+#if !defined(_WIN32)
+  if (m_Socket >= 0)
+    close(m_Socket);
+  if (!m_Path.empty())
+    unlink(m_Path.c_str());
+#endif
+
+  m_Socket = -1;
+  m_Path.clear();
+}
+
+void GUI::RemoteServer::Accept(void) noexcept
+{
+#if !defined(_WIN32)
+  for (int socket = accept(m_Socket, nullptr, nullptr); socket >= 0; socket = accept(m_Socket, nullptr, nullptr))
+  {
+    PrepareSocket(socket);
+
+    // A new viewer has nothing yet, every tile of the next frame is dirty for it
+    Client client = Client();
+    client.socket = socket;
+    client.dirty.assign((size_t)m_Columns*m_Rows, 1);
+
+    GUI::RemoteHello hello;
+    memcpy(hello.magic, "GUIR", 4);
+    hello.version = REMOTE_VERSION;
+    client.output.append((const char*)&hello, sizeof(hello));
+    m_Clients.push_back(std::move(client));
+  }
+#endif
+}
+
+bool GUI::RemoteServer::Read(Client& client) noexcept
+{
+#if !defined(_WIN32)
+  size_t received = 0;
+  bool open = ReadSocket(client.socket, client.input, received);
+
+  size_t offset = 0;
+  while (client.input.size()-offset >= sizeof(GUI::RemoteMessage))
+  {
+    GUI::RemoteMessage message;
+    memcpy(&message, client.input.data()+offset, sizeof(message));
+    if (message.size > MAX_INPUT_MESSAGE)
+      return false;
+    if (client.input.size()-offset-sizeof(message) < message.size)
+      break;
+
+    const char* payload = client.input.data()+offset+sizeof(message);
+    offset += sizeof(message)+message.size;
+
+    // Unknown messages are skipped so newer viewers can talk to older servers
+    if (message.type == GUI::REMOTE_MESSAGE_MOUSE && message.size == sizeof(GUI::RemoteMouse))
+    {
+      GUI::RemoteMouse mouse;
+      memcpy(&mouse, payload, sizeof(mouse));
+      m_MousePosition = { mouse.x, mouse.y };
+      // A click shorter than a frame still has to be seen
+      if (mouse.down && !m_MouseDown)
+        m_MousePressed = true;
+      m_MouseDown = mouse.down;
+    }
+    else if (message.type == GUI::REMOTE_MESSAGE_KEY && message.size == sizeof(GUI::RemoteKey) && m_Focus)
+    {
+      GUI::RemoteKey key;
+      memcpy(&key, payload, sizeof(key));
+      m_Focus->SetKeyDown(key.key, key.down);
+      if (key.down)
+      {
+        m_Focus->PushKey(key.key);
+        client.keysDown.push_back(key.key);
+      }
+      else
+      {
+        client.keysDown.erase(std::remove(client.keysDown.begin(), client.keysDown.end(), key.key), client.keysDown.end());
+      }
+    }
+    else if (message.type == GUI::REMOTE_MESSAGE_CHAR && message.size == sizeof(GUI::RemoteChar) && m_Focus)
+    {
+      GUI::RemoteChar character;
+      memcpy(&character, payload, sizeof(character));
+      m_Focus->PushChar(character.codepoint);
+    }
+  }
+
+  client.input.erase(0, offset);
+  return open;
+#else
+  (void)client;
+  return false;
+#endif
+}
+
+bool GUI::RemoteServer::Flush(Client& client) noexcept
+{
+#if !defined(_WIN32)
+  if (!WriteSocket(client.socket, client.output, client.outputOffset))
+    return false;
+
+  if (client.outputOffset == client.output.size())
+  {
+    client.output.clear();
+    client.outputOffset = 0;
+  }
+  return true;
+#else
+  (void)client;
+  return false;
+#endif
+}
+
+void GUI::RemoteServer::Disconnect(size_t index) noexcept
+{
+  // Keys held on a viewer that went away would otherwise stay down forever, whichever call noticed it
+  Client& client = m_Clients[index];
+  if (m_Focus)
+  {
+    for (int key : client.keysDown)
+      m_Focus->SetKeyDown(key, false);
+  }
+
+#if !defined(_WIN32)
+  close(client.socket);
+#endif
+  m_Clients.erase(m_Clients.begin()+index);
+
+  if (m_Clients.empty())
+    m_MouseDown = false;
+}
+
+void GUI::RemoteServer::Poll(GUI::MouseState& mouseState, GUI::FocusManager* focus) noexcept
+{
+  // Called after FocusManager::BeginFrame, the viewers' keys join the frame's queue
+  m_Focus = focus;
+  if (m_Socket >= 0)
+    Accept();
+
+  for (size_t i = m_Clients.size(); i--;)
+  {
+    if (!Read(m_Clients[i]) || !Flush(m_Clients[i]))
+      Disconnect(i);
+  }
+
+  mouseState.position = m_MousePosition;
+  mouseState.pressed = m_MousePressed;
+  mouseState.down = m_MouseDown;
+  m_MousePressed = false;
+}
+
+const std::string& GUI::RemoteServer::EncodeTile(size_t tile)
+{
+  // Encoded once per frame however many viewers need the tile
+  std::string& encoded = m_Tiles[tile];
+  if (m_TileFrames[tile] == m_Stats.frame)
+    return encoded;
+
+  int x = (int)(tile%m_Columns)*m_TileSize;
+  int y = (int)(tile/m_Columns)*m_TileSize;
+  int width = m_Width-x < m_TileSize ? m_Width-x : m_TileSize;
+  int height = m_Height-y < m_TileSize ? m_Height-y : m_TileSize;
+
+  // The tile's rows are already contiguous in the copy kept for diffing
+  std::vector<uint32_t> pixels((size_t)width*height);
+  for (int row = 0; row < height; row++)
+    memcpy(&pixels[(size_t)row*width], &m_Previous[(size_t)(y+row)*m_Width+x], (size_t)width*4);
+
+  GUI::RemoteTile header = GUI::RemoteTile();
+  header.column = tile%m_Columns;
+  header.row = tile/m_Columns;
+
+  encoded.assign(sizeof(header), '\0');
+  EncodePixels(pixels.data(), pixels.size(), encoded);
+  header.size = encoded.size()-sizeof(header);
+  memcpy(&encoded[0], &header, sizeof(header));
+
+  m_TileFrames[tile] = m_Stats.frame;
+  m_Stats.encodedBytes += encoded.size();
+  return encoded;
+}
+
+void GUI::RemoteServer::SendFrame(const Image& image)
+{
+  m_Stats.frame++;
+  m_Stats.clientCount = m_Clients.size();
+  m_Stats.changedTileCount = 0;
+  m_Stats.encodedBytes = 0;
+  m_Stats.sentBytes = 0;
+  m_Stats.diffMilliseconds = 0;
+  m_Stats.encodeMilliseconds = 0;
+
+  if (image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || image.width <= 0 || image.height <= 0 || image.width > UINT16_MAX || image.height > UINT16_MAX)
+  {
+    TraceLog(LOG_WARNING, "GUI: Remote frames must be R8G8B8A8 and at most 65535 pixels wide and high");
+    return;
+  }
+
+  // Without viewers there is nothing to diff against, the first viewer gets a whole frame anyway
+  if (m_Clients.empty())
+  {
+    m_Width = 0;
+    m_Height = 0;
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  bool resized = image.width != m_Width || image.height != m_Height;
+  if (resized)
+  {
+    m_Width = image.width;
+    m_Height = image.height;
+    m_Columns = (m_Width+m_TileSize-1)/m_TileSize;
+    m_Rows = (m_Height+m_TileSize-1)/m_TileSize;
+    m_Previous.assign((size_t)m_Width*m_Height, 0);
+    m_Tiles.assign((size_t)m_Columns*m_Rows, std::string());
+    m_TileFrames.assign((size_t)m_Columns*m_Rows, 0);
+  }
+
+  size_t tileCount = (size_t)m_Columns*m_Rows;
+  m_Changed.assign(tileCount, resized);
+  m_Stats.tileCount = tileCount;
+
+  // Row by row so the copy kept for the next frame is updated in the same pass
+  const uint32_t* pixels = (const uint32_t*)image.data;
+  for (int y = 0; y < m_Height; y++)
+  {
+    const uint32_t* source = pixels+(size_t)y*m_Width;
+    uint32_t* previous = &m_Previous[(size_t)y*m_Width];
+    uint8_t* changed = &m_Changed[(size_t)(y/m_TileSize)*m_Columns];
+    for (int column = 0; column < m_Columns; column++)
+    {
+      int x = column*m_TileSize;
+      size_t bytes = (size_t)(m_Width-x < m_TileSize ? m_Width-x : m_TileSize)*4;
+      if (memcmp(previous+x, source+x, bytes))
+      {
+        memcpy(previous+x, source+x, bytes);
+        changed[column] = 1;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < tileCount; i++)
+    m_Stats.changedTileCount += m_Changed[i];
+
+  auto diffed = std::chrono::steady_clock::now();
+  m_Stats.diffMilliseconds = Milliseconds(start, diffed);
+
+  GUI::RemoteFrame frame = GUI::RemoteFrame();
+  frame.frame = m_Stats.frame;
+  frame.width = m_Width;
+  frame.height = m_Height;
+  frame.tileSize = m_TileSize;
+
+  for (size_t i = m_Clients.size(); i--;)
+  {
+    Client& client = m_Clients[i];
+    if (client.dirty.size() != tileCount || resized)
+      client.dirty.assign(tileCount, 1);
+
+    // Viewers still sending an earlier frame just collect dirty tiles, whatever is sent later comes from the newest frame
+    frame.tileCount = 0;
+    for (size_t tile = 0; tile < tileCount; tile++)
+    {
+      client.dirty[tile] |= m_Changed[tile];
+      frame.tileCount += client.dirty[tile];
+    }
+
+    if (!frame.tileCount || client.output.size()-client.outputOffset > MAX_PENDING_BYTES)
+      continue;
+
+    // The message size is patched in once the tiles are appended
+    size_t begin = client.output.size();
+    client.output.append(sizeof(GUI::RemoteMessage), '\0');
+    client.output.append((const char*)&frame, sizeof(frame));
+    for (size_t tile = 0; tile < tileCount; tile++)
+    {
+      if (!client.dirty[tile])
+        continue;
+
+      client.output.append(EncodeTile(tile));
+      client.dirty[tile] = 0;
+    }
+
+    GUI::RemoteMessage message = GUI::RemoteMessage();
+    message.type = GUI::REMOTE_MESSAGE_FRAME;
+    message.size = client.output.size()-begin-sizeof(message);
+    memcpy(&client.output[begin], &message, sizeof(message));
+    m_Stats.sentBytes += client.output.size()-begin;
+
+    if (!Flush(client))
+      Disconnect(i);
+  }
+
+  m_Stats.encodeMilliseconds = Milliseconds(diffed, std::chrono::steady_clock::now());
+  m_Stats.clientCount = m_Clients.size();
+}
+
+size_t GUI::RemoteServer::GetClientCount(void) const noexcept
+{
+  return m_Clients.size();
+}
+
+const GUI::RemoteStats& GUI::RemoteServer::GetStats(void) const noexcept
+{
+  return m_Stats;
+}
+
+GUI::RemoteClient::RemoteClient(void)
+  : m_Socket(-1), m_Greeted(false), m_ReceivedBytes(0)
+{ }
+
+GUI::RemoteClient::~RemoteClient(void)
+{
+  Close();
+}
+
+bool GUI::RemoteClient::Connect(const char* address) noexcept
+{
+  Close();
+
+#if !defined(_WIN32)
+  std::string path;
+  m_Socket = OpenSocket(address, false, path);
+  if (m_Socket < 0)
+  {
+    TraceLog(LOG_WARNING, "GUI: Failed to connect to \"%s\"", address);
+    return false;
+  }
+
+  PrepareSocket(m_Socket);
+  return true;
+#else
+  TraceLog(LOG_WARNING, "GUI: Remote streaming is not supported on Windows, cannot connect to \"%s\"", address);
+  return false;
+#endif
+}
+
+void GUI::RemoteClient::Close(void) noexcept
+{
+#if !defined(_WIN32)
+  if (m_Socket >= 0)
+    close(m_Socket);
+#endif
+
+  m_Socket = -1;
+  m_Greeted = false;
+  m_Input.clear();
+  m_Output.clear();
+}
+
+bool GUI::RemoteClient::IsConnected(void) const noexcept
+{
+  return m_Socket >= 0;
+}
+
+size_t GUI::RemoteClient::GetReceivedBytes(void) const noexcept
+{
+  return m_ReceivedBytes;
+}
+
+bool GUI::RemoteClient::Flush(void) noexcept
+{
+#if !defined(_WIN32)
+  size_t offset = 0;
+  bool open = WriteSocket(m_Socket, m_Output, offset);
+  m_Output.erase(0, offset);
+  return open;
+#else
+  return false;
+#endif
+}
+
+void GUI::RemoteClient::Send(GUI::RemoteMessageTypes type, const void* payload, uint32_t size) noexcept
+{
+  if (m_Socket < 0)
+    return;
+
+  AppendMessage(m_Output, type, payload, size);
+  if (!Flush())
+    Close();
+}
+
+void GUI::RemoteClient::SendMouse(Vector2 position, bool down) noexcept
+{
+  GUI::RemoteMouse mouse = GUI::RemoteMouse();
+  mouse.x = position.x;
+  mouse.y = position.y;
+  mouse.down = down;
+  Send(GUI::REMOTE_MESSAGE_MOUSE, &mouse, sizeof(mouse));
+}
+
+void GUI::RemoteClient::SendKey(int key, bool down) noexcept
+{
+  GUI::RemoteKey remoteKey = GUI::RemoteKey();
+  remoteKey.key = key;
+  remoteKey.down = down;
+  Send(GUI::REMOTE_MESSAGE_KEY, &remoteKey, sizeof(remoteKey));
+}
+
+void GUI::RemoteClient::SendChar(int codepoint) noexcept
+{
+  GUI::RemoteChar character = GUI::RemoteChar();
+  character.codepoint = codepoint;
+  Send(GUI::REMOTE_MESSAGE_CHAR, &character, sizeof(character));
+}
+
+bool GUI::RemoteClient::ApplyFrame(Image& image, const unsigned char* data, size_t size)
+{
+  GUI::RemoteFrame frame;
+  if (size < sizeof(frame))
+    return false;
+  memcpy(&frame, data, sizeof(frame));
+  data += sizeof(frame);
+  size -= sizeof(frame);
+
+  if (!frame.width || !frame.height || !frame.tileSize)
+    return false;
+
+  // A new size starts from a blank image, the server sends every tile with it
+  if (image.width != frame.width || image.height != frame.height || image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || !image.data)
+  {
+    if (image.data)
+      UnloadImage(image);
+    image = GenImageColor(frame.width, frame.height, BLANK);
+  }
+
+  // The tile size comes off the wire, no tile holds more pixels than the frame so the buffer never outgrows the image
+  int columns = (frame.width+frame.tileSize-1)/frame.tileSize;
+  int rows = (frame.height+frame.tileSize-1)/frame.tileSize;
+  size_t tileWidth = frame.tileSize < frame.width ? frame.tileSize : frame.width;
+  size_t tileHeight = frame.tileSize < frame.height ? frame.tileSize : frame.height;
+  std::vector<uint32_t> pixels(tileWidth*tileHeight);
+  uint32_t* target = (uint32_t*)image.data;
+
+  for (uint32_t i = 0; i < frame.tileCount; i++)
+  {
+    GUI::RemoteTile tile;
+    if (size < sizeof(tile))
+      return false;
+    memcpy(&tile, data, sizeof(tile));
+    data += sizeof(tile);
+    size -= sizeof(tile);
+
+    if (tile.column >= columns || tile.row >= rows || tile.size > size)
+      return false;
+
+    int x = tile.column*frame.tileSize;
+    int y = tile.row*frame.tileSize;
+    int width = frame.width-x < frame.tileSize ? frame.width-x : frame.tileSize;
+    int height = frame.height-y < frame.tileSize ? frame.height-y : frame.tileSize;
+    if (!DecodePixels(data, tile.size, pixels.data(), (size_t)width*height))
+      return false;
+    data += tile.size;
+    size -= tile.size;
+
+    for (int row = 0; row < height; row++)
+      memcpy(&target[(size_t)(y+row)*frame.width+x], &pixels[(size_t)row*width], (size_t)width*4);
+  }
+
+  return size == 0;
+}
+
+bool GUI::RemoteClient::Receive(Image& image)
+{
+  if (m_Socket < 0)
+    return false;
+
+#if !defined(_WIN32)
+  bool open = ReadSocket(m_Socket, m_Input, m_ReceivedBytes) && Flush();
+#else
+  bool open = false;
+#endif
+
+  size_t offset = 0;
+  if (!m_Greeted && m_Input.size() >= sizeof(GUI::RemoteHello))
+  {
+    GUI::RemoteHello hello;
+    memcpy(&hello, m_Input.data(), sizeof(hello));
+    if (memcmp(hello.magic, "GUIR", 4) || hello.version != REMOTE_VERSION)
+    {
+      TraceLog(LOG_WARNING, "GUI: Remote server speaks an unknown protocol");
+      Close();
+      return false;
+    }
+
+    m_Greeted = true;
+    offset = sizeof(hello);
+  }
+
+  bool changed = false;
+  while (m_Greeted && m_Input.size()-offset >= sizeof(GUI::RemoteMessage))
+  {
+    GUI::RemoteMessage message;
+    memcpy(&message, m_Input.data()+offset, sizeof(message));
+    if (m_Input.size()-offset-sizeof(message) < message.size)
+      break;
+
+    const unsigned char* payload = (const unsigned char*)m_Input.data()+offset+sizeof(message);
+    offset += sizeof(message)+message.size;
+    if (message.type != GUI::REMOTE_MESSAGE_FRAME)
+      continue;
+
+    if (!ApplyFrame(image, payload, message.size))
+    {
+      TraceLog(LOG_WARNING, "GUI: Malformed frame from the remote server");
+      Close();
+      return changed;
+    }
+    changed = true;
+  }
+
+  m_Input.erase(0, offset);
+  if (!open)
+    Close();
+  return changed;
+}
@@ -0,0 +1,55 @@
+#include "../../include/gui.hpp"
+
+GUI::Snapshot::Snapshot(int width, int height, Color backgroundColor)
+  : m_Image(GenImageColor(width, height, backgroundColor)), m_BackgroundColor(backgroundColor)
+{ }
+
+GUI::Snapshot::~Snapshot(void)
+{
+  UnloadImage(m_Image);
+}
+
+void GUI::Snapshot::AddFont(const Font& font, const Image& atlas)
+{
+  m_Tiles.AddFont(font, atlas);
+}
+
+GUI::Button& GUI::Snapshot::AddButton(Rectangle bounds, const GUI::ButtonStyle& style, const std::string& text)
+{
+  m_Widgets.push_back({ GUI::LAYOUT_WIDGET_BUTTON, m_Buttons.size() });
+  m_Buttons.emplace_back(bounds, style, text);
+  return m_Buttons.back();
+}
+
+GUI::Input& GUI::Snapshot::AddInput(Rectangle bounds, const GUI::InputStyle& style, const std::string& placeholderText, const std::string& text)
+{
+  m_Widgets.push_back({ GUI::LAYOUT_WIDGET_INPUT, m_Inputs.size() });
+  m_Inputs.emplace_back(bounds, style, placeholderText);
+  if (!text.empty())
+    m_Inputs.back().SetText(text);
+  return m_Inputs.back();
+}
+
+const Image& GUI::Snapshot::Render(GUI::ThreadPool* pool)
+{
+  ImageClearBackground(&m_Image, m_BackgroundColor);
+  m_Tiles.Clear();
+
+  // Widgets are recorded in the order they were added, like a frame of UpdateAndRender calls
+  for (const Widget& widget : m_Widgets)
+  {
+    if (widget.type == GUI::LAYOUT_WIDGET_BUTTON)
+      m_Buttons[widget.index].DrawToTiles(m_Tiles);
+    else
+      m_Inputs[widget.index].DrawToTiles(m_Tiles);
+  }
+
+  m_Tiles.Render(m_Image, pool);
+
+  return m_Image;
+}
+
+bool GUI::Snapshot::Export(const char* fileName) const noexcept
+{
+  return ExportImage(m_Image, fileName);
+}
@@ -0,0 +1,633 @@
+#include "../../include/gui.hpp"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+  // Edge pixels are shaded this many at a time, so their coverage lives on the stack
+  constexpr int SPAN_CHUNK = 64;
+}
+
+static inline float Clamp01(float value) noexcept
+{
+  return value < 0 ? 0 : (value > 1 ? 1 : value);
+}
+
+static void BlendPixel(unsigned char* pixel, Color color, float coverage) noexcept
+{
+  float srcAlpha = (color.a/255.0f)*coverage;
+  if (srcAlpha <= 0)
+    return;
+
+  // Same operations in the same order as the vector kernels, so a pixel comes out the same whichever path or tile draws it
+  float dstWeight = pixel[3]*(1/255.0f)*(1-srcAlpha);
+  float outAlpha = srcAlpha+dstWeight;
+  float invAlpha = 1/outAlpha;
+
+  pixel[0] = (unsigned char)((color.r*srcAlpha+pixel[0]*dstWeight)*invAlpha+0.5f);
+  pixel[1] = (unsigned char)((color.g*srcAlpha+pixel[1]*dstWeight)*invAlpha+0.5f);
+  pixel[2] = (unsigned char)((color.b*srcAlpha+pixel[2]*dstWeight)*invAlpha+0.5f);
+  pixel[3] = (unsigned char)(outAlpha*255+0.5f);
+}
+
+// BlendPixel over count pixels, a whole vector of pixels at a time. Coverage is per pixel, or full when null.
+// Opaque colors at full coverage are stored without reading the destination.
+static void BlendSpan(unsigned char* pixels, int count, Color color, const float* coverage) noexcept
+{
+  int i = 0;
+
+  if (!coverage && color.a == 255)
+  {
+    uint32_t value;
+    memcpy(&value, &color, sizeof(value));
+
+#if defined(__AVX2__)
+    const __m256i fill = _mm256_set1_epi32((int)value);
+    for (; i+8 <= count; i += 8)
+      _mm256_storeu_si256((__m256i*)(pixels+i*4), fill);
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128i fill = _mm_set1_epi32((int)value);
+    for (; i+4 <= count; i += 4)
+      _mm_storeu_si128((__m128i*)(pixels+i*4), fill);
+#endif
+
+    for (; i < count; i++)
+      memcpy(pixels+i*4, &value, sizeof(value));
+    return;
+  }
+
+  float alpha = color.a/255.0f;
+
+#if defined(__AVX2__)
+  // Pixels are split into one float vector per channel, R8G8B8A8 is R in the low byte of each 32 bit pixel
+  const __m256i byteMask = _mm256_set1_epi32(0xFF);
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 one = _mm256_set1_ps(1);
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256 full = _mm256_set1_ps(255);
+  const __m256 inv255 = _mm256_set1_ps(1/255.0f);
+  const __m256 srcR = _mm256_set1_ps(color.r);
+  const __m256 srcG = _mm256_set1_ps(color.g);
+  const __m256 srcB = _mm256_set1_ps(color.b);
+
+  for (; i+8 <= count; i += 8)
+  {
+    __m256 srcAlpha = _mm256_set1_ps(alpha);
+    if (coverage)
+      srcAlpha = _mm256_mul_ps(srcAlpha, _mm256_loadu_ps(coverage+i));
+
+    __m256 visible = _mm256_cmp_ps(srcAlpha, zero, _CMP_GT_OQ);
+    if (!_mm256_movemask_ps(visible))
+      continue;
+
+    __m256i dst = _mm256_loadu_si256((const __m256i*)(pixels+i*4));
+    __m256 dstR = _mm256_cvtepi32_ps(_mm256_and_si256(dst, byteMask));
+    __m256 dstG = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(dst, 8), byteMask));
+    __m256 dstB = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(dst, 16), byteMask));
+    __m256 dstA = _mm256_cvtepi32_ps(_mm256_srli_epi32(dst, 24));
+
+    __m256 dstWeight = _mm256_mul_ps(_mm256_mul_ps(dstA, inv255), _mm256_sub_ps(one, srcAlpha));
+    __m256 outAlpha = _mm256_add_ps(srcAlpha, dstWeight);
+    __m256 invAlpha = _mm256_div_ps(one, _mm256_blendv_ps(one, outAlpha, visible));
+
+    __m256i r = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(srcR, srcAlpha), _mm256_mul_ps(dstR, dstWeight)), invAlpha), half));
+    __m256i g = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(srcG, srcAlpha), _mm256_mul_ps(dstG, dstWeight)), invAlpha), half));
+    __m256i b = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(srcB, srcAlpha), _mm256_mul_ps(dstB, dstWeight)), invAlpha), half));
+    __m256i a = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(outAlpha, full), half));
+
+    __m256i result = _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)), _mm256_or_si256(_mm256_slli_epi32(b, 16), _mm256_slli_epi32(a, 24)));
+    _mm256_storeu_si256((__m256i*)(pixels+i*4), _mm256_blendv_epi8(dst, result, _mm256_castps_si256(visible)));
+  }
+#elif defined(__SSE2__) || defined(_M_X64)
+  const __m128i byteMask = _mm_set1_epi32(0xFF);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 full = _mm_set1_ps(255);
+  const __m128 inv255 = _mm_set1_ps(1/255.0f);
+  const __m128 srcR = _mm_set1_ps(color.r);
+  const __m128 srcG = _mm_set1_ps(color.g);
+  const __m128 srcB = _mm_set1_ps(color.b);
+
+  for (; i+4 <= count; i += 4)
+  {
+    __m128 srcAlpha = _mm_set1_ps(alpha);
+    if (coverage)
+      srcAlpha = _mm_mul_ps(srcAlpha, _mm_loadu_ps(coverage+i));
+
+    __m128 visible = _mm_cmpgt_ps(srcAlpha, zero);
+    if (!_mm_movemask_ps(visible))
+      continue;
+
+    __m128i dst = _mm_loadu_si128((const __m128i*)(pixels+i*4));
+    __m128 dstR = _mm_cvtepi32_ps(_mm_and_si128(dst, byteMask));
+    __m128 dstG = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(dst, 8), byteMask));
+    __m128 dstB = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(dst, 16), byteMask));
+    __m128 dstA = _mm_cvtepi32_ps(_mm_srli_epi32(dst, 24));
+
+    // No blendv before SSE4.1, lanes without coverage divide by one instead of zero
+    __m128 dstWeight = _mm_mul_ps(_mm_mul_ps(dstA, inv255), _mm_sub_ps(one, srcAlpha));
+    __m128 outAlpha = _mm_add_ps(srcAlpha, dstWeight);
+    __m128 invAlpha = _mm_div_ps(one, _mm_or_ps(_mm_and_ps(visible, outAlpha), _mm_andnot_ps(visible, one)));
+
+    __m128i r = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(srcR, srcAlpha), _mm_mul_ps(dstR, dstWeight)), invAlpha), half));
+    __m128i g = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(srcG, srcAlpha), _mm_mul_ps(dstG, dstWeight)), invAlpha), half));
+    __m128i b = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(srcB, srcAlpha), _mm_mul_ps(dstB, dstWeight)), invAlpha), half));
+    __m128i a = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(outAlpha, full), half));
+
+    __m128i result = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)), _mm_or_si128(_mm_slli_epi32(b, 16), _mm_slli_epi32(a, 24)));
+    __m128i keep = _mm_castps_si128(visible);
+    _mm_storeu_si128((__m128i*)(pixels+i*4), _mm_or_si128(_mm_and_si128(keep, result), _mm_andnot_si128(keep, dst)));
+  }
+#endif
+
+  for (; i < count; i++)
+    BlendPixel(pixels+i*4, color, coverage ? coverage[i] : 1);
+}
+
+// Signed distance from a pixel center to a rounded rectangle, negative inside
+static float RoundedDistance(float x, float y, Rectangle rec, float radius) noexcept
+{
+  float qx = fabsf(x-(rec.x+rec.width/2))-(rec.width/2-radius);
+  float qy = fabsf(y-(rec.y+rec.height/2))-(rec.height/2-radius);
+  float ox = qx > 0 ? qx : 0;
+  float oy = qy > 0 ? qy : 0;
+  float inside = qx > qy ? qx : qy;
+
+  return sqrtf(ox*ox+oy*oy)+(inside < 0 ? inside : 0)-radius;
+}
+
+static float RoundedRadius(Rectangle rec, float roundness) noexcept
+{
+  if (roundness <= 0)
+    return 0;
+  if (roundness > 1)
+    roundness = 1;
+
+  return (rec.width > rec.height ? rec.height : rec.width)*roundness/2;
+}
+
+static void ClipSpan(const Image& image, Rectangle rec, const Rectangle* clip, int& x0, int& y0, int& x1, int& y1) noexcept
+{
+  x0 = (int)floorf(rec.x);
+  y0 = (int)floorf(rec.y);
+  x1 = (int)ceilf(rec.x+rec.width);
+  y1 = (int)ceilf(rec.y+rec.height);
+
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 > image.width) x1 = image.width;
+  if (y1 > image.height) y1 = image.height;
+
+  if (clip)
+  {
+    // Pixels are kept when their center is inside the clip rect
+    int clipX0 = (int)ceilf(clip->x-0.5f);
+    int clipY0 = (int)ceilf(clip->y-0.5f);
+    int clipX1 = (int)ceilf(clip->x+clip->width-0.5f);
+    int clipY1 = (int)ceilf(clip->y+clip->height-0.5f);
+    if (x0 < clipX0) x0 = clipX0;
+    if (y0 < clipY0) y0 = clipY0;
+    if (x1 > clipX1) x1 = clipX1;
+    if (y1 > clipY1) y1 = clipY1;
+  }
+}
+
+// Pixels of row center y that are at least half a pixel inside the rounded rect, so their coverage is exactly one.
+// That region is the rounded rect shrunk by half a pixel, whose half width on a row has a closed form.
+static void InteriorSpan(float y, Rectangle rec, float radius, int x0, int x1, int& interior0, int& interior1) noexcept
+{
+  float halfWidth = rec.width/2-0.5f;
+  float halfHeight = rec.height/2-0.5f;
+  float innerRadius = radius > 0.5f ? radius-0.5f : 0;
+  float rowWidth = -1;
+
+  float corner = fabsf(y-(rec.y+rec.height/2))-(halfHeight-innerRadius);
+  if (halfWidth > 0 && halfHeight > 0)
+  {
+    if (corner <= 0)
+      rowWidth = halfWidth;
+    else if (corner < innerRadius)
+      rowWidth = halfWidth-innerRadius+sqrtf(innerRadius*innerRadius-corner*corner);
+  }
+
+  interior0 = interior1 = x0;
+  if (rowWidth < 0)
+    return;
+
+  float center = rec.x+rec.width/2;
+  interior0 = (int)ceilf(center-rowWidth-0.5f);
+  interior1 = (int)floorf(center+rowWidth-0.5f)+1;
+
+  if (interior0 < x0) interior0 = x0;
+  if (interior1 > x1) interior1 = x1;
+  if (interior1 < interior0) interior0 = interior1 = x0;
+}
+
+// Coverage of count pixels starting at x on row y, from the rounded rect distance.
+// Either the filled shape, or a line of lineThickness outside of it.
+static void RowCoverage(float x, float y, int count, Rectangle rec, float radius, bool outline, float lineThickness, float* coverage) noexcept
+{
+  // The vertical term is the same for the whole row
+  float centerX = rec.x+rec.width/2;
+  float extentX = rec.width/2-radius;
+  float qy = fabsf(y-(rec.y+rec.height/2))-(rec.height/2-radius);
+  float oy = qy > 0 ? qy*qy : 0;
+  int i = 0;
+
+#if defined(__AVX2__)
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 one = _mm256_set1_ps(1);
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 lanes = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256 center = _mm256_set1_ps(centerX);
+  const __m256 extent = _mm256_set1_ps(extentX);
+  const __m256 vertical = _mm256_set1_ps(qy);
+  const __m256 vertical2 = _mm256_set1_ps(oy);
+  const __m256 rounded = _mm256_set1_ps(radius);
+  const __m256 thickness = _mm256_set1_ps(lineThickness);
+
+  for (; i+8 <= count; i += 8)
+  {
+    __m256 px = _mm256_add_ps(_mm256_set1_ps(x+i), lanes);
+    __m256 qx = _mm256_sub_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(px, center)), extent);
+    __m256 ox = _mm256_max_ps(qx, zero);
+    __m256 inside = _mm256_min_ps(_mm256_max_ps(qx, vertical), zero);
+    __m256 distance = _mm256_sub_ps(_mm256_add_ps(_mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(ox, ox), vertical2)), inside), rounded);
+
+    __m256 value = _mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(half, outline ? _mm256_sub_ps(distance, thickness) : distance), zero), one);
+    if (outline)
+      value = _mm256_mul_ps(value, _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(half, distance), zero), one));
+    _mm256_storeu_ps(coverage+i, value);
+  }
+#elif defined(__SSE2__) || defined(_M_X64)
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  const __m128 lanes = _mm_setr_ps(0, 1, 2, 3);
+  const __m128 center = _mm_set1_ps(centerX);
+  const __m128 extent = _mm_set1_ps(extentX);
+  const __m128 vertical = _mm_set1_ps(qy);
+  const __m128 vertical2 = _mm_set1_ps(oy);
+  const __m128 rounded = _mm_set1_ps(radius);
+  const __m128 thickness = _mm_set1_ps(lineThickness);
+
+  for (; i+4 <= count; i += 4)
+  {
+    __m128 px = _mm_add_ps(_mm_set1_ps(x+i), lanes);
+    __m128 qx = _mm_sub_ps(_mm_andnot_ps(sign, _mm_sub_ps(px, center)), extent);
+    __m128 ox = _mm_max_ps(qx, zero);
+    __m128 inside = _mm_min_ps(_mm_max_ps(qx, vertical), zero);
+    __m128 distance = _mm_sub_ps(_mm_add_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(ox, ox), vertical2)), inside), rounded);
+
+    __m128 value = _mm_min_ps(_mm_max_ps(_mm_sub_ps(half, outline ? _mm_sub_ps(distance, thickness) : distance), zero), one);
+    if (outline)
+      value = _mm_mul_ps(value, _mm_min_ps(_mm_max_ps(_mm_add_ps(half, distance), zero), one));
+    _mm_storeu_ps(coverage+i, value);
+  }
+#endif
+
+  for (; i < count; i++)
+  {
+    float distance = RoundedDistance(x+i, y, rec, radius);
+    coverage[i] = outline ? Clamp01(0.5f-(distance-lineThickness))*Clamp01(0.5f+distance) : Clamp01(0.5f-distance);
+  }
+}
+
+// Blends [x0, x1) of a row with its rounded rect coverage
+static void ShadeSpan(unsigned char* row, int x0, int x1, float y, Rectangle rec, float radius, bool outline, float lineThickness, Color color) noexcept
+{
+  float coverage[SPAN_CHUNK];
+  for (int start = x0; start < x1; start += SPAN_CHUNK)
+  {
+    int count = x1-start < SPAN_CHUNK ? x1-start : SPAN_CHUNK;
+    RowCoverage(start+0.5f, y, count, rec, radius, outline, lineThickness, coverage);
+    BlendSpan(row+start*4, count, color, coverage);
+  }
+}
+
+void GUI::Software::DrawRectangle(Image& image, Rectangle rec, Color color, const Rectangle* clip) noexcept
+{
+  int x0, y0, x1, y1;
+  ClipSpan(image, rec, clip, x0, y0, x1, y1);
+  if (x1 <= x0)
+    return;
+
+  unsigned char* pixels = (unsigned char*)image.data;
+  for (int y = y0; y < y1; y++)
+    BlendSpan(pixels+(y*image.width+x0)*4, x1-x0, color, nullptr);
+}
+
+void GUI::Software::DrawRectangleRounded(Image& image, Rectangle rec, float roundness, Color color, const Rectangle* clip) noexcept
+{
+  float radius = RoundedRadius(rec, roundness);
+
+  int x0, y0, x1, y1;
+  ClipSpan(image, rec, clip, x0, y0, x1, y1);
+  if (x1 <= x0)
+    return;
+
+  // Only the edges and corners need the distance, the interior of each row is one solid span
+  unsigned char* pixels = (unsigned char*)image.data;
+  for (int y = y0; y < y1; y++)
+  {
+    unsigned char* row = pixels+y*image.width*4;
+    int interior0, interior1;
+    InteriorSpan(y+0.5f, rec, radius, x0, x1, interior0, interior1);
+
+    ShadeSpan(row, x0, interior0, y+0.5f, rec, radius, false, 0, color);
+    BlendSpan(row+interior0*4, interior1-interior0, color, nullptr);
+    ShadeSpan(row, interior1, x1, y+0.5f, rec, radius, false, 0, color);
+  }
+}
+
+void GUI::Software::DrawRectangleRoundedLines(Image& image, Rectangle rec, float roundness, float lineThickness, Color color, const Rectangle* clip) noexcept
+{
+  // Matches raylib, the line sits outside of the rectangle
+  float radius = RoundedRadius(rec, roundness);
+  Rectangle outer = { rec.x-lineThickness, rec.y-lineThickness, rec.width+lineThickness*2, rec.height+lineThickness*2 };
+
+  int x0, y0, x1, y1;
+  ClipSpan(image, outer, clip, x0, y0, x1, y1);
+  if (x1 <= x0)
+    return;
+
+  // Pixels fully inside the rectangle have no line coverage, so each row only shades the two edge runs around them
+  unsigned char* pixels = (unsigned char*)image.data;
+  for (int y = y0; y < y1; y++)
+  {
+    unsigned char* row = pixels+y*image.width*4;
+    int interior0, interior1;
+    InteriorSpan(y+0.5f, rec, radius, x0, x1, interior0, interior1);
+
+    ShadeSpan(row, x0, interior0, y+0.5f, rec, radius, true, lineThickness, color);
+    ShadeSpan(row, interior1, x1, y+0.5f, rec, radius, true, lineThickness, color);
+  }
+}
+
+namespace
+{
+  // Horizontal half of the bilinear filter for one destination column. Texels outside of the atlas get no weight.
+  struct SampleColumn
+  {
+    int left;
+    int right;
+    float leftWeight;
+    float rightWeight;
+  };
+}
+
+// Columns of count pixels starting at pixel x, shared by every row of a glyph.
+// Each column is mapped on its own so the result does not depend on where a clip or tile starts the span.
+static void SampleColumns(const Image& atlas, Rectangle source, Rectangle dest, float scaleFactor, int x, int count, SampleColumn* columns) noexcept
+{
+  for (int i = 0; i < count; i++)
+  {
+    float sx = source.x+(x+i+0.5f-dest.x)/scaleFactor-0.5f;
+    int ix = (int)floorf(sx);
+    float fx = sx-ix;
+
+    SampleColumn& column = columns[i];
+    column.left = ix < 0 ? 0 : (ix >= atlas.width ? atlas.width-1 : ix)*2+1;
+    column.right = ix+1 < 0 ? 0 : (ix+1 >= atlas.width ? atlas.width-1 : ix+1)*2+1;
+    column.leftWeight = ix >= 0 && ix < atlas.width ? (1-fx)/255.0f : 0;
+    column.rightWeight = ix+1 >= 0 && ix+1 < atlas.width ? fx/255.0f : 0;
+  }
+}
+
+// Bilinear coverage of one row of a gray+alpha atlas at texel row y
+static void SampleRow(const Image& atlas, const SampleColumn* columns, float y, int count, float* coverage) noexcept
+{
+  y -= 0.5f;
+  int iy = (int)floorf(y);
+  float fy = y-iy;
+
+  // Rows outside of the atlas get no weight, and read the first row instead
+  const unsigned char* pixels = (const unsigned char*)atlas.data;
+  float topWeight = iy >= 0 && iy < atlas.height ? 1-fy : 0;
+  float bottomWeight = iy+1 >= 0 && iy+1 < atlas.height ? fy : 0;
+  const unsigned char* top = topWeight > 0 ? pixels+iy*atlas.width*2 : pixels;
+  const unsigned char* bottom = bottomWeight > 0 ? pixels+(iy+1)*atlas.width*2 : pixels;
+
+  for (int i = 0; i < count; i++)
+  {
+    const SampleColumn& column = columns[i];
+    float upper = top[column.left]*column.leftWeight+top[column.right]*column.rightWeight;
+    float lower = bottom[column.left]*column.leftWeight+bottom[column.right]*column.rightWeight;
+    coverage[i] = upper*topWeight+lower*bottomWeight;
+  }
+}
+
+void GUI::Software::DrawTextEx(Image& image, const Image& atlas, Font font, const char* text, Vector2 position, float fontSize, float spacing, Color tint, const Rectangle* clip) noexcept
+{
+  if (!atlas.data || !font.glyphs)
+    return;
+
+  float scaleFactor = fontSize/font.baseSize;
+  float textOffsetX = 0;
+  unsigned char* pixels = (unsigned char*)image.data;
+  float coverage[SPAN_CHUNK];
+  SampleColumn columns[SPAN_CHUNK];
+
+  for (int i = 0; text[i];)
+  {
+    int next;
+    int codepoint = GetCodepointNext(text+i, &next);
+    int index = GetGlyphIndex(font, codepoint);
+    i += next;
+
+    if (codepoint != ' ' && codepoint != '\t')
+    {
+      float padding = (float)font.glyphPadding;
+      Rectangle source = { font.recs[index].x-padding, font.recs[index].y-padding, font.recs[index].width+padding*2, font.recs[index].height+padding*2 };
+      Rectangle dest = { position.x+textOffsetX+(font.glyphs[index].offsetX-padding)*scaleFactor, position.y+(font.glyphs[index].offsetY-padding)*scaleFactor, source.width*scaleFactor, source.height*scaleFactor };
+
+      int x0, y0, x1, y1;
+      ClipSpan(image, dest, clip, x0, y0, x1, y1);
+
+      for (int start = x0; start < x1; start += SPAN_CHUNK)
+      {
+        int count = x1-start < SPAN_CHUNK ? x1-start : SPAN_CHUNK;
+        SampleColumns(atlas, source, dest, scaleFactor, start, count, columns);
+
+        for (int y = y0; y < y1; y++)
+        {
+          SampleRow(atlas, columns, source.y+(y+0.5f-dest.y)/scaleFactor, count, coverage);
+          BlendSpan(pixels+(y*image.width+start)*4, count, tint, coverage);
+        }
+      }
+    }
+
+    if (font.glyphs[index].advanceX)
+      textOffsetX += font.glyphs[index].advanceX*scaleFactor+spacing;
+    else
+      textOffsetX += font.recs[index].width*scaleFactor+spacing;
+  }
+}
+
+void GUI::Software::DrawImage(Image& image, const Image& source, Rectangle sourceRec, Rectangle dest, Color tint, const Rectangle* clip) noexcept
+{
+  if (!source.data || source.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || sourceRec.width <= 0 || sourceRec.height <= 0 || dest.width <= 0 || dest.height <= 0)
+    return;
+
+  // Pixels whose center is inside dest, like the GPU fills a quad
+  int x0, y0, x1, y1;
+  ClipSpan(image, dest, clip, x0, y0, x1, y1);
+  int destX0 = (int)ceilf(dest.x-0.5f);
+  int destY0 = (int)ceilf(dest.y-0.5f);
+  int destX1 = (int)ceilf(dest.x+dest.width-0.5f);
+  int destY1 = (int)ceilf(dest.y+dest.height-0.5f);
+  if (x0 < destX0) x0 = destX0;
+  if (y0 < destY0) y0 = destY0;
+  if (x1 > destX1) x1 = destX1;
+  if (y1 > destY1) y1 = destY1;
+  if (x1 <= x0 || y1 <= y0)
+    return;
+
+  // Samples are clamped to sourceRec, so nothing outside of it bleeds in however the image is scaled
+  int left = (int)sourceRec.x < 0 ? 0 : (int)sourceRec.x;
+  int top = (int)sourceRec.y < 0 ? 0 : (int)sourceRec.y;
+  int right = (int)(sourceRec.x+sourceRec.width)-1 < source.width-1 ? (int)(sourceRec.x+sourceRec.width)-1 : source.width-1;
+  int bottom = (int)(sourceRec.y+sourceRec.height)-1 < source.height-1 ? (int)(sourceRec.y+sourceRec.height)-1 : source.height-1;
+  if (right < left || bottom < top)
+    return;
+
+  float scaleX = sourceRec.width/dest.width;
+  float scaleY = sourceRec.height/dest.height;
+  const unsigned char* texels = (const unsigned char*)source.data;
+  unsigned char* pixels = (unsigned char*)image.data;
+
+  for (int y = y0; y < y1; y++)
+  {
+    float sy = sourceRec.y+(y+0.5f-dest.y)*scaleY-0.5f;
+    int iy = (int)floorf(sy);
+    float fy = sy-iy;
+    int row0 = iy < top ? top : (iy > bottom ? bottom : iy);
+    int row1 = iy+1 < top ? top : (iy+1 > bottom ? bottom : iy+1);
+
+    for (int x = x0; x < x1; x++)
+    {
+      float sx = sourceRec.x+(x+0.5f-dest.x)*scaleX-0.5f;
+      int ix = (int)floorf(sx);
+      float fx = sx-ix;
+      int column0 = ix < left ? left : (ix > right ? right : ix);
+      int column1 = ix+1 < left ? left : (ix+1 > right ? right : ix+1);
+
+      // Weighted by alpha, so transparent texels do not darken the edges
+      const unsigned char* samples[4] = { texels+(row0*source.width+column0)*4, texels+(row0*source.width+column1)*4, texels+(row1*source.width+column0)*4, texels+(row1*source.width+column1)*4 };
+      float weights[4] = { (1-fx)*(1-fy), fx*(1-fy), (1-fx)*fy, fx*fy };
+      float alpha = 0;
+      float red = 0;
+      float green = 0;
+      float blue = 0;
+      for (int i = 0; i < 4; i++)
+      {
+        float weight = samples[i][3]*weights[i];
+        alpha += weight;
+        red += samples[i][0]*weight;
+        green += samples[i][1]*weight;
+        blue += samples[i][2]*weight;
+      }
+
+      if (alpha <= 0)
+        continue;
+
+      Color color = { (unsigned char)(red/alpha*tint.r/255+0.5f), (unsigned char)(green/alpha*tint.g/255+0.5f), (unsigned char)(blue/alpha*tint.b/255+0.5f), tint.a };
+      BlendPixel(pixels+(y*image.width+x)*4, color, alpha/255);
+    }
+  }
+}
+
+Rectangle GUI::Software::MeasureTextBounds(Font font, const char* text, Vector2 position, float fontSize, float spacing) noexcept
+{
+  // Union of the padded glyph quads DrawTextEx blends, empty when nothing is drawn
+  if (!font.glyphs)
+    return { position.x, position.y, 0, 0 };
+
+  float scaleFactor = fontSize/font.baseSize;
+  float textOffsetX = 0;
+  float left = 0, top = 0, right = 0, bottom = 0;
+  bool empty = true;
+
+  for (int i = 0; text[i];)
+  {
+    int next;
+    int codepoint = GetCodepointNext(text+i, &next);
+    int index = GetGlyphIndex(font, codepoint);
+    i += next;
+
+    if (codepoint != ' ' && codepoint != '\t')
+    {
+      float padding = (float)font.glyphPadding;
+      float x = position.x+textOffsetX+(font.glyphs[index].offsetX-padding)*scaleFactor;
+      float y = position.y+(font.glyphs[index].offsetY-padding)*scaleFactor;
+      float width = (font.recs[index].width+padding*2)*scaleFactor;
+      float height = (font.recs[index].height+padding*2)*scaleFactor;
+
+      if (empty || x < left) left = x;
+      if (empty || y < top) top = y;
+      if (empty || x+width > right) right = x+width;
+      if (empty || y+height > bottom) bottom = y+height;
+      empty = false;
+    }
+
+    if (font.glyphs[index].advanceX)
+      textOffsetX += font.glyphs[index].advanceX*scaleFactor+spacing;
+    else
+      textOffsetX += font.recs[index].width*scaleFactor+spacing;
+  }
+
+  if (empty)
+    return { position.x, position.y, 0, 0 };
+
+  return { left, top, right-left, bottom-top };
+}
+
+bool GUI::Software::LoadFont(const char* fileName, int fontSize, Font& font, Image& atlas) noexcept
+{
+  unsigned int fileSize = 0;
+  unsigned char* fileData = LoadFileData(fileName, &fileSize);
+  if (!fileData)
+    return false;
+
+  // Same rasterization and packing as LoadFontEx with the default ASCII set, minus the texture upload
+  font = Font();
+  font.baseSize = fontSize;
+  font.glyphCount = 95;
+  font.glyphPadding = 4;
+  font.glyphs = LoadFontData(fileData, fileSize, fontSize, nullptr, font.glyphCount, FONT_DEFAULT);
+  UnloadFileData(fileData);
+  if (!font.glyphs)
+  {
+    TraceLog(LOG_WARNING, "GUI: Cannot rasterize %s at %d", fileName, fontSize);
+    font = Font();
+    return false;
+  }
+
+  atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, fontSize, font.glyphPadding, 0);
+  ImageFormat(&atlas, PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA);
+  return true;
+}
+
+void GUI::Software::UnloadFont(Font& font, Image& atlas) noexcept
+{
+  if (font.glyphs)
+    UnloadFontData(font.glyphs, font.glyphCount);
+  if (font.recs)
+    MemFree(font.recs);
+  if (atlas.data)
+    UnloadImage(atlas);
+
+  font = Font();
+  atlas = Image();
+  GUI::Text::InvalidateGlyphTables();
+}
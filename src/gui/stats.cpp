@@ -0,0 +1,83 @@
+#include "../../include/gui.hpp"
+
+#include <cstdlib>
+#include <new>
+
+thread_local size_t GUI::Stats::allocationsThisFrame = 0;
+thread_local size_t GUI::Stats::bytesThisFrame = 0;
+thread_local size_t GUI::Stats::allocationsTotal = 0;
+
+void GUI::Stats::BeginFrame(void) noexcept
+{
+  allocationsThisFrame = 0;
+  bytesThisFrame = 0;
+}
+
+size_t GUI::Stats::EndFrame(void) noexcept
+{
+#ifdef GUI_COUNT_ALLOCATIONS
+  if (allocationsThisFrame)
+    TraceLog(LOG_WARNING, "GUI: %zu heap allocations (%zu bytes) this frame", allocationsThisFrame, bytesThisFrame);
+#endif
+
+  return allocationsThisFrame;
+}
+
+#ifdef GUI_COUNT_ALLOCATIONS
+
+static void* CountedAllocate(size_t size) noexcept
+{
+  GUI::Stats::allocationsThisFrame++;
+  GUI::Stats::bytesThisFrame += size;
+  GUI::Stats::allocationsTotal++;
+
+  return std::malloc(size ? size : 1);
+}
+
+void* operator new(size_t size)
+{
+  void* ptr = CountedAllocate(size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new[](size_t size)
+{
+  void* ptr = CountedAllocate(size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+  return CountedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+  return CountedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+#endif
@@ -0,0 +1,74 @@
+#include "../../include/gui.hpp"
+
+#include <string.h>
+
+namespace
+{
+  // Fixed chunks that are never moved or freed, so references handed out stay valid and readers never take the lock.
+  // 256 chunks of 256 styles cover every handle.
+  constexpr size_t STYLE_CHUNK = 256;
+
+  struct InputStyleTable
+  {
+    std::unique_ptr<GUI::InputStyle[]> chunks[STYLE_CHUNK];
+    std::atomic<size_t> count;
+    std::mutex mutex;
+
+    InputStyleTable(void)
+      : count(1)
+    {
+      chunks[0].reset(new GUI::InputStyle[STYLE_CHUNK]());
+    }
+  };
+
+  InputStyleTable& InputStyles(void)
+  {
+    static InputStyleTable styles;
+    return styles;
+  }
+}
+
+GUI::StyleHandle GUI::Styles::InternInput(const GUI::InputStyle& style)
+{
+  // Widgets are built on several threads by snapshot jobs, only interning is serialized
+  InputStyleTable& styles = InputStyles();
+  std::lock_guard<std::mutex> lock(styles.mutex);
+  size_t count = styles.count.load(std::memory_order_relaxed);
+
+  // Screens use a handful of styles, a linear scan over them is cheaper than hashing each one.
+  // Copies with different padding bytes only cost a duplicate entry.
+  for (size_t i = 0; i < count; i++)
+  {
+    if (!memcmp(&styles.chunks[i/STYLE_CHUNK][i%STYLE_CHUNK], &style, sizeof(GUI::InputStyle)))
+      return i;
+  }
+
+  if (count > UINT16_MAX)
+  {
+    TraceLog(LOG_WARNING, "GUI: More than %d input styles, falling back to the default style", UINT16_MAX);
+    return 0;
+  }
+
+  if (!styles.chunks[count/STYLE_CHUNK])
+    styles.chunks[count/STYLE_CHUNK].reset(new GUI::InputStyle[STYLE_CHUNK]());
+  styles.chunks[count/STYLE_CHUNK][count%STYLE_CHUNK] = style;
+  styles.count.store(count+1, std::memory_order_release);
+  return count;
+}
+
+const GUI::InputStyle& GUI::Styles::GetInput(GUI::StyleHandle handle) noexcept
+{
+  InputStyleTable& styles = InputStyles();
+  if (handle >= styles.count.load(std::memory_order_acquire))
+    handle = 0;
+
+  return styles.chunks[handle/STYLE_CHUNK][handle%STYLE_CHUNK];
+}
+
+void GUI::Styles::ReportMemory(GUI::MemoryReport& report)
+{
+  InputStyleTable& styles = InputStyles();
+  size_t count = styles.count.load(std::memory_order_acquire);
+  size_t chunks = (count+STYLE_CHUNK-1)/STYLE_CHUNK;
+  report.Add("style", "InputStyle", sizeof(InputStyleTable)+chunks*STYLE_CHUNK*sizeof(GUI::InputStyle), count);
+}
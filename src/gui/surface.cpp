@@ -0,0 +1,219 @@
+#include "../../include/gui.hpp"
+#include "../../include/rlgl.h"
+
+GUI::SurfaceCache::SurfaceCache(void)
+  : SurfaceCache(1024, 1024, GUI::SURFACE_BACKEND_GPU)
+{ }
+
+GUI::SurfaceCache::SurfaceCache(int width, int height, GUI::SurfaceBackends backend)
+  : m_Width(width), m_Height(height), m_Backend(backend), m_Target(), m_Image(), m_Texture(), m_TextureDirty(false), m_Generation(1), m_ShelfX(0), m_ShelfY(0), m_ShelfHeight(0), m_Allocations(0), m_Draws(0), m_Overflowed(false)
+{ }
+
+GUI::SurfaceCache::~SurfaceCache(void)
+{
+  for (FontAtlas& fontAtlas : m_FontAtlases)
+    UnloadImage(fontAtlas.image);
+
+  if (m_Image.data)
+    UnloadImage(m_Image);
+
+  // The GPU objects are already gone when the cache outlives the window
+  if (!IsWindowReady())
+    return;
+
+  if (m_Target.id)
+    UnloadRenderTexture(m_Target);
+  if (m_Texture.id)
+    UnloadTexture(m_Texture);
+}
+
+void GUI::SurfaceCache::Load(void) noexcept
+{
+  // GPU resources are created on first use so a cache can be declared before InitWindow
+  if (m_Backend == SURFACE_BACKEND_GPU)
+  {
+    if (!m_Target.id)
+      m_Target = LoadRenderTexture(m_Width, m_Height);
+    return;
+  }
+
+  if (!m_Image.data)
+    m_Image = GenImageColor(m_Width, m_Height, BLANK);
+  if (!m_Tiles)
+    m_Tiles.reset(new GUI::TileRenderer());
+  if (!m_Texture.id)
+    m_Texture = LoadTextureFromImage(m_Image);
+}
+
+bool GUI::SurfaceCache::Acquire(GUI::SurfaceSlot& slot, int width, int height, GUI::TextBatcher* textBatcher) noexcept
+{
+  if (slot.generation == m_Generation && slot.region.width >= width && slot.region.height >= height)
+    return true;
+
+  if (width > m_Width || height > m_Height || m_Overflowed)
+    return false;
+
+  // Shelf packing, when the atlas is full every surface is dropped and re-rendered on demand
+  if (m_ShelfX+width > m_Width)
+  {
+    m_ShelfX = 0;
+    m_ShelfY += m_ShelfHeight;
+    m_ShelfHeight = 0;
+  }
+
+  if (m_ShelfY+height > m_Height)
+  {
+    // Full again before any surface was drawn twice, clearing would re-render everything every frame
+    if (m_Draws <= m_Allocations)
+    {
+      TraceLog(LOG_WARNING, "GUI: %dx%d surface cache is too small for its widgets, new surfaces draw directly until Clear", m_Width, m_Height);
+      m_Overflowed = true;
+      return false;
+    }
+
+    // Blits still queued this frame read regions that are about to be drawn over
+    if (textBatcher)
+      textBatcher->Flush();
+
+    Clear();
+    return Acquire(slot, width, height, textBatcher);
+  }
+
+  slot.region = { (float)m_ShelfX, (float)m_ShelfY, (float)width, (float)height };
+  slot.generation = m_Generation;
+  slot.valid = false;
+
+  m_ShelfX += width;
+  if (height > m_ShelfHeight)
+    m_ShelfHeight = height;
+  m_Allocations++;
+
+  return true;
+}
+
+bool GUI::SurfaceCache::IsResident(const GUI::SurfaceSlot& slot) const noexcept
+{
+  return slot.generation == m_Generation;
+}
+
+void GUI::SurfaceCache::BeginSurface(const GUI::SurfaceSlot& slot) noexcept
+{
+  Load();
+
+  if (m_Backend == SURFACE_BACKEND_GPU)
+  {
+    BeginTextureMode(m_Target);
+    BeginScissorMode(slot.region.x, slot.region.y, slot.region.width, slot.region.height);
+    ClearBackground(BLANK);
+
+    // Alpha accumulates instead of being multiplied in twice, which leaves the color premultiplied
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    return;
+  }
+
+  ImageDrawRectangleRec(&m_Image, slot.region, BLANK);
+  m_Tiles->Clear();
+  m_TextureDirty = true;
+}
+
+void GUI::SurfaceCache::EndSurface(void) noexcept
+{
+  if (m_Backend == SURFACE_BACKEND_GPU)
+  {
+    EndBlendMode();
+    EndScissorMode();
+    EndTextureMode();
+    return;
+  }
+
+  // One surface is too small to be worth spreading over threads
+  m_Tiles->Render(m_Image, nullptr);
+}
+
+void GUI::SurfaceCache::DrawSurface(const GUI::SurfaceSlot& slot, GUI::TextBatcher* textBatcher)
+{
+  Rectangle destination = { slot.origin.x, slot.origin.y, slot.region.width, slot.region.height };
+  m_Draws++;
+
+  if (m_Backend == SURFACE_BACKEND_GPU)
+  {
+    // Render textures are stored bottom-up and hold premultiplied color
+    Rectangle source = { slot.region.x, m_Height-slot.region.y-slot.region.height, slot.region.width, -slot.region.height };
+    if (textBatcher)
+    {
+      textBatcher->AddSurface(m_Target.texture, source, destination);
+      return;
+    }
+
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTexturePro(m_Target.texture, source, destination, { 0, 0 }, 0, WHITE);
+    EndBlendMode();
+    return;
+  }
+
+  if (m_TextureDirty)
+  {
+    UpdateTexture(m_Texture, m_Image.data);
+    m_TextureDirty = false;
+  }
+
+  DrawTexturePro(m_Texture, slot.region, destination, { 0, 0 }, 0, WHITE);
+}
+
+void GUI::SurfaceCache::Clear(void) noexcept
+{
+  m_Generation++;
+  m_ShelfX = 0;
+  m_ShelfY = 0;
+  m_ShelfHeight = 0;
+  m_Allocations = 0;
+  m_Draws = 0;
+  m_Overflowed = false;
+}
+
+GUI::SurfaceBackends GUI::SurfaceCache::GetBackend(void) const noexcept
+{
+  return m_Backend;
+}
+
+GUI::TileRenderer& GUI::SurfaceCache::GetTiles(void) noexcept
+{
+  Load();
+  return *m_Tiles;
+}
+
+const Image& GUI::SurfaceCache::GetFontAtlas(const Font& font) noexcept
+{
+  for (const FontAtlas& fontAtlas : m_FontAtlases)
+  {
+    if (fontAtlas.textureId == font.texture.id)
+      return fontAtlas.image;
+  }
+
+  // Read back once so the CPU path can rasterize glyphs
+  FontAtlas fontAtlas = { font.texture.id, LoadImageFromTexture(font.texture) };
+  ImageFormat(&fontAtlas.image, PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA);
+  m_FontAtlases.push_back(fontAtlas);
+
+  return m_FontAtlases.back().image;
+}
+
+void GUI::SurfaceCache::ReportMemory(GUI::MemoryReport& report) const
+{
+  // GPU memory is reported apart from the CPU side
+  size_t bytes = sizeof(GUI::SurfaceCache)+m_FontAtlases.capacity()*sizeof(FontAtlas);
+  if (m_Image.data)
+    bytes += GetPixelDataSize(m_Image.width, m_Image.height, m_Image.format);
+  for (const FontAtlas& fontAtlas : m_FontAtlases)
+    bytes += GetPixelDataSize(fontAtlas.image.width, fontAtlas.image.height, fontAtlas.image.format);
+  report.Add("cache", "SurfaceCache", bytes);
+
+  size_t textureBytes = 0;
+  if (m_Target.id)
+    textureBytes += GetPixelDataSize(m_Target.texture.width, m_Target.texture.height, m_Target.texture.format);
+  if (m_Texture.id)
+    textureBytes += GetPixelDataSize(m_Texture.width, m_Texture.height, m_Texture.format);
+  if (textureBytes)
+    report.Add("texture", "SurfaceCache", textureBytes);
+}
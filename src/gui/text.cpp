@@ -0,0 +1,200 @@
+#include "../../include/gui.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+  // Integer advances of the ASCII glyphs of one font, so ASCII runs never search the glyph list
+  struct GlyphTable
+  {
+    const GlyphInfo* glyphs;
+    unsigned int textureId;
+    int baseSize;
+    int glyphCount;
+    int advances[128];
+  };
+
+  constexpr int GLYPH_TABLE_COUNT = 8;
+
+  thread_local GlyphTable glyphTables[GLYPH_TABLE_COUNT];
+  thread_local int nextGlyphTable = 0;
+
+  // Bumped when a font is unloaded, each thread drops its tables the next time it sees a new value
+  std::atomic<uint32_t> glyphTableGeneration(0);
+  thread_local uint32_t seenGlyphTableGeneration = 0;
+}
+
+static int GlyphAdvance(const Font& font, int index) noexcept
+{
+  if (font.glyphs[index].advanceX)
+    return font.glyphs[index].advanceX;
+
+  return (int)font.recs[index].width+font.glyphs[index].offsetX;
+}
+
+static const GlyphTable& GetGlyphTable(const Font& font) noexcept
+{
+  uint32_t generation = glyphTableGeneration.load(std::memory_order_relaxed);
+  if (generation != seenGlyphTableGeneration)
+  {
+    for (GlyphTable& table : glyphTables)
+      table.glyphs = nullptr;
+    seenGlyphTableGeneration = generation;
+  }
+
+  // A font loaded where an unloaded one was can reuse its glyph array and texture id, the sizes tell most of them apart
+  for (const GlyphTable& table : glyphTables)
+  {
+    if (table.glyphs == font.glyphs && table.textureId == font.texture.id && table.baseSize == font.baseSize && table.glyphCount == font.glyphCount)
+      return table;
+  }
+
+  GlyphTable& table = glyphTables[nextGlyphTable];
+  nextGlyphTable = (nextGlyphTable+1)%GLYPH_TABLE_COUNT;
+
+  table.glyphs = font.glyphs;
+  table.textureId = font.texture.id;
+  table.baseSize = font.baseSize;
+  table.glyphCount = font.glyphCount;
+  for (int c = 0; c < 128; c++)
+    table.advances[c] = GlyphAdvance(font, GetGlyphIndex(font, c));
+
+  return table;
+}
+
+// Length of the all ASCII prefix, whole vectors at a time
+static size_t AsciiRun(const unsigned char* text, size_t length) noexcept
+{
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  for (; i+32 <= length; i += 32)
+  {
+    if (_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*)(text+i))))
+      break;
+  }
+#elif defined(__SSE2__) || defined(_M_X64)
+  for (; i+16 <= length; i += 16)
+  {
+    if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(text+i))))
+      break;
+  }
+#endif
+
+  while (i < length && text[i] < 0x80)
+    i++;
+
+  return i;
+}
+
+// Sum of the table advances of an ASCII run
+static int SumAdvances(const GlyphTable& table, const unsigned char* text, size_t length) noexcept
+{
+  size_t i = 0;
+  int sum = 0;
+
+#if defined(__AVX2__)
+  __m256i total = _mm256_setzero_si256();
+  for (; i+8 <= length; i += 8)
+  {
+    __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(text+i)));
+    total = _mm256_add_epi32(total, _mm256_i32gather_epi32(table.advances, indices, 4));
+  }
+
+  __m128i half = _mm_add_epi32(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+  sum = _mm_cvtsi128_si32(half);
+#else
+  for (; i+4 <= length; i += 4)
+    sum += table.advances[text[i]]+table.advances[text[i+1]]+table.advances[text[i+2]]+table.advances[text[i+3]];
+#endif
+
+  for (; i < length; i++)
+    sum += table.advances[text[i]];
+
+  return sum;
+}
+
+float GUI::Text::MeasureRange(const Font& font, const char* text, size_t length, float fontSize, float spacing) noexcept
+{
+  if (!length || !font.glyphs)
+    return 0;
+
+  const GlyphTable& table = GetGlyphTable(font);
+  const unsigned char* bytes = (const unsigned char*)text;
+  int advance = 0;
+  size_t codepoints = 0;
+
+  for (size_t i = 0; i < length;)
+  {
+    size_t run = AsciiRun(bytes+i, length-i);
+    if (run)
+    {
+      advance += SumAdvances(table, bytes+i, run);
+      codepoints += run;
+      i += run;
+      continue;
+    }
+
+    int next;
+    int codepoint = GetCodepointNext(text+i, &next);
+    advance += GlyphAdvance(font, GetGlyphIndex(font, codepoint));
+    codepoints++;
+    i += next;
+  }
+
+  return advance*(fontSize/font.baseSize)+(codepoints-1)*spacing;
+}
+
+size_t GUI::Text::IndexAtX(const Font& font, const char* text, size_t length, float fontSize, float spacing, float x) noexcept
+{
+  if (!length || !font.glyphs || x <= 0)
+    return 0;
+
+  const GlyphTable& table = GetGlyphTable(font);
+  const unsigned char* bytes = (const unsigned char*)text;
+  float scaleFactor = fontSize/font.baseSize;
+  float position = 0;
+
+  for (size_t i = 0; i < length;)
+  {
+    // Skip whole ASCII blocks that end before x
+    size_t run = AsciiRun(bytes+i, length-i < 32 ? length-i : 32);
+    if (run == 32)
+    {
+      float width = SumAdvances(table, bytes+i, run)*scaleFactor+run*spacing;
+      if (position+width < x)
+      {
+        position += width;
+        i += run;
+        continue;
+      }
+    }
+
+    int next = 1;
+    float glyphWidth;
+    if (bytes[i] < 0x80)
+      glyphWidth = table.advances[bytes[i]]*scaleFactor;
+    else
+      glyphWidth = GlyphAdvance(font, GetGlyphIndex(font, GetCodepointNext(text+i, &next)))*scaleFactor;
+
+    // The caret goes to whichever side of the glyph is closer
+    if (position+glyphWidth/2 >= x)
+      return i;
+
+    position += glyphWidth+spacing;
+    i += next;
+  }
+
+  return length;
+}
+
+void GUI::Text::InvalidateGlyphTables(void) noexcept
+{
+  glyphTableGeneration.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,130 @@
+#include "../../include/gui.hpp"
+
+GUI::TextBatcher::TextBatcher(void)
+  : m_LastBatch(0)
+{ }
+
+std::vector<GUI::GlyphQuad>& GUI::TextBatcher::GetQuads(Texture2D texture, bool premultiplied)
+{
+  // Widgets mostly share one or two atlases, so the previous batch is almost always the right one
+  if (m_LastBatch >= m_Batches.size() || m_Batches[m_LastBatch].texture.id != texture.id || m_Batches[m_LastBatch].premultiplied != premultiplied)
+  {
+    m_LastBatch = 0;
+    while (m_LastBatch < m_Batches.size() && (m_Batches[m_LastBatch].texture.id != texture.id || m_Batches[m_LastBatch].premultiplied != premultiplied))
+      m_LastBatch++;
+
+    if (m_LastBatch == m_Batches.size())
+      m_Batches.push_back({ texture, premultiplied, std::vector<GUI::GlyphQuad>() });
+  }
+
+  // A reloaded atlas can come back under the same id with another size, the quads are drawn with the latest one
+  Batch& batch = m_Batches[m_LastBatch];
+  batch.texture = texture;
+  return batch.quads;
+}
+
+void GUI::TextBatcher::AddText(Font font, const char* text, Vector2 position, float fontSize, float spacing, Color tint, const GUI::ClipStack* clip)
+{
+  if (!font.glyphs || !font.recs || !text[0])
+    return;
+
+  std::vector<GUI::GlyphQuad>& quads = GetQuads(font.texture, false);
+  Rectangle bounds = clip ? clip->GetRect() : Rectangle{ 0, 0, 0, 0 };
+  float scaleFactor = fontSize/font.baseSize;
+  float padding = (float)font.glyphPadding;
+  float textOffsetX = 0;
+
+  for (int i = 0; text[i];)
+  {
+    int next;
+    int codepoint = GetCodepointNext(text+i, &next);
+    int index = GetGlyphIndex(font, codepoint);
+    i += next;
+
+    float x = position.x+textOffsetX;
+    if (clip && !clip->IsEmpty() && x > bounds.x+bounds.width)
+      break;
+
+    if (codepoint != ' ' && codepoint != '\t')
+    {
+      GUI::GlyphQuad quad;
+      quad.source = { font.recs[index].x-padding, font.recs[index].y-padding, font.recs[index].width+padding*2, font.recs[index].height+padding*2 };
+      quad.dest = { x+(font.glyphs[index].offsetX-padding)*scaleFactor, position.y+(font.glyphs[index].offsetY-padding)*scaleFactor, quad.source.width*scaleFactor, quad.source.height*scaleFactor };
+      quad.tint = tint;
+
+      if (!clip || clip->ClipQuad(quad.source, quad.dest))
+        quads.push_back(quad);
+    }
+
+    if (font.glyphs[index].advanceX)
+      textOffsetX += font.glyphs[index].advanceX*scaleFactor+spacing;
+    else
+      textOffsetX += font.recs[index].width*scaleFactor+spacing;
+  }
+}
+
+void GUI::TextBatcher::AddQuad(Texture2D texture, Rectangle source, Rectangle dest, Color tint, const GUI::ClipStack* clip)
+{
+  // Icons from an AtlasPacker, every widget drawing from the same atlas lands in one batch
+  if (!texture.id || (clip && !clip->ClipQuad(source, dest)))
+    return;
+
+  GetQuads(texture, false).push_back({ source, dest, tint });
+}
+
+void GUI::TextBatcher::AddSurface(Texture2D texture, Rectangle source, Rectangle dest)
+{
+  if (texture.id)
+    GetQuads(texture, true).push_back({ source, dest, WHITE });
+}
+
+void GUI::TextBatcher::Flush(void) noexcept
+{
+  // Switching the blend mode flushes raylib's batch, so every premultiplied quad goes first under a single switch
+  bool premultiplied = false;
+  for (Batch& batch : m_Batches)
+  {
+    if (!batch.premultiplied || batch.quads.empty())
+      continue;
+
+    if (!premultiplied)
+    {
+      BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+      premultiplied = true;
+    }
+
+    for (const GUI::GlyphQuad& quad : batch.quads)
+      DrawTexturePro(batch.texture, quad.source, quad.dest, { 0, 0 }, 0, quad.tint);
+    batch.quads.clear();
+  }
+
+  if (premultiplied)
+    EndBlendMode();
+
+  // Consecutive quads on one texture are merged into a single draw call by raylib's batch
+  for (Batch& batch : m_Batches)
+  {
+    for (const GUI::GlyphQuad& quad : batch.quads)
+      DrawTexturePro(batch.texture, quad.source, quad.dest, { 0, 0 }, 0, quad.tint);
+
+    batch.quads.clear();
+  }
+}
+
+size_t GUI::TextBatcher::GetQuadCount(void) const noexcept
+{
+  size_t count = 0;
+  for (const Batch& batch : m_Batches)
+    count += batch.quads.size();
+
+  return count;
+}
+
+void GUI::TextBatcher::ReportMemory(GUI::MemoryReport& report) const
+{
+  size_t bytes = sizeof(GUI::TextBatcher)+m_Batches.capacity()*sizeof(Batch);
+  for (const Batch& batch : m_Batches)
+    bytes += batch.quads.capacity()*sizeof(GUI::GlyphQuad);
+
+  report.Add("cache", "TextBatcher", bytes);
+}
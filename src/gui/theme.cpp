@@ -0,0 +1,35 @@
+#include "../../include/gui.hpp"
+
+namespace
+{
+  const GUI::Theme* activeTheme = nullptr;
+  uint32_t themeGeneration = 1;
+}
+
+Color GUI::ResolveColor(Color color) noexcept
+{
+  if (!GUI::IsPaletteColor(color))
+    return color;
+
+  return activeTheme ? activeTheme->colors[color.r] : BLANK;
+}
+
+void GUI::ApplyTheme(const GUI::Theme* theme) noexcept
+{
+  // The theme is referenced, not copied, so switching costs the same however many widgets use it
+  if (theme == activeTheme)
+    return;
+
+  activeTheme = theme;
+  themeGeneration++;
+}
+
+const GUI::Theme* GUI::GetTheme(void) noexcept
+{
+  return activeTheme;
+}
+
+uint32_t GUI::GetThemeGeneration(void) noexcept
+{
+  return themeGeneration;
+}
@@ -0,0 +1,74 @@
+#include "../../include/gui.hpp"
+
+GUI::ThreadPool::ThreadPool(void)
+  : ThreadPool(std::thread::hardware_concurrency())
+{ }
+
+GUI::ThreadPool::ThreadPool(size_t threadCount)
+  : m_Running(0), m_Quit(false)
+{
+  // hardware_concurrency is 0 when unknown
+  if (!threadCount)
+    threadCount = 1;
+
+  m_Threads.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; i++)
+    m_Threads.emplace_back(&GUI::ThreadPool::Run, this);
+}
+
+GUI::ThreadPool::~ThreadPool(void)
+{
+  // Jobs already queued still run, so nothing submitted is silently dropped
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Quit = true;
+  }
+
+  m_Condition.notify_all();
+  for (std::thread& thread : m_Threads)
+    thread.join();
+}
+
+void GUI::ThreadPool::Submit(std::function<void(void)> job)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Jobs.push_back(std::move(job));
+  }
+
+  m_Condition.notify_one();
+}
+
+void GUI::ThreadPool::Wait(void) noexcept
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_Idle.wait(lock, [this] { return m_Jobs.empty() && !m_Running; });
+}
+
+size_t GUI::ThreadPool::GetThreadCount(void) const noexcept
+{
+  return m_Threads.size();
+}
+
+void GUI::ThreadPool::Run(void) noexcept
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  for (;;)
+  {
+    m_Condition.wait(lock, [this] { return m_Quit || !m_Jobs.empty(); });
+    if (m_Jobs.empty())
+      return;
+
+    std::function<void(void)> job = std::move(m_Jobs.front());
+    m_Jobs.pop_front();
+    m_Running++;
+
+    lock.unlock();
+    job();
+    lock.lock();
+
+    m_Running--;
+    if (m_Jobs.empty() && !m_Running)
+      m_Idle.notify_all();
+  }
+}
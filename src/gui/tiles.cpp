@@ -0,0 +1,281 @@
+#include "../../include/gui.hpp"
+
+#include <math.h>
+
+#include <chrono>
+
+static float Milliseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) noexcept
+{
+  return std::chrono::duration<float, std::milli>(end-start).count();
+}
+
+static Rectangle Intersect(Rectangle a, Rectangle b) noexcept
+{
+  float left = a.x > b.x ? a.x : b.x;
+  float top = a.y > b.y ? a.y : b.y;
+  float right = a.x+a.width < b.x+b.width ? a.x+a.width : b.x+b.width;
+  float bottom = a.y+a.height < b.y+b.height ? a.y+a.height : b.y+b.height;
+
+  return { left, top, right > left ? right-left : 0, bottom > top ? bottom-top : 0 };
+}
+
+GUI::TileRenderer::TileRenderer(void)
+  : TileRenderer(GUI::SOFTWARE_TILE_SIZE)
+{ }
+
+GUI::TileRenderer::TileRenderer(int tileSize)
+  : m_TileSize(tileSize > 0 ? tileSize : GUI::SOFTWARE_TILE_SIZE), m_Columns(0), m_Rows(0), m_Stats()
+{ }
+
+void GUI::TileRenderer::AddFont(const Font& font, const Image& atlas)
+{
+  for (FontAtlas& fontAtlas : m_Fonts)
+  {
+    if (fontAtlas.glyphs == font.glyphs)
+    {
+      fontAtlas.atlas = &atlas;
+      return;
+    }
+  }
+
+  m_Fonts.push_back({ font.glyphs, &atlas });
+}
+
+const Image& GUI::TileRenderer::GetFontAtlas(const Font& font) const noexcept
+{
+  for (const FontAtlas& fontAtlas : m_Fonts)
+  {
+    if (fontAtlas.glyphs == font.glyphs)
+      return *fontAtlas.atlas;
+  }
+
+  // Text in a font that was never added is skipped when the tiles are drawn
+  static const Image noAtlas = Image();
+  return noAtlas;
+}
+
+void GUI::TileRenderer::Record(Command& command, Rectangle bounds, const Rectangle* clip)
+{
+  command.bounds = bounds;
+  command.clipped = clip != nullptr;
+  command.clip = clip ? *clip : Rectangle();
+  m_Commands.push_back(command);
+}
+
+void GUI::TileRenderer::DrawRectangle(Rectangle rec, Color color, const Rectangle* clip)
+{
+  Command command = Command();
+  command.type = COMMAND_RECTANGLE;
+  command.color = color;
+  command.rec = rec;
+  Record(command, rec, clip);
+}
+
+void GUI::TileRenderer::DrawRectangleRounded(Rectangle rec, float roundness, Color color, const Rectangle* clip)
+{
+  Command command = Command();
+  command.type = COMMAND_ROUNDED;
+  command.color = color;
+  command.rec = rec;
+  command.roundness = roundness;
+  Record(command, rec, clip);
+}
+
+void GUI::TileRenderer::DrawRectangleRoundedLines(Rectangle rec, float roundness, float lineThickness, Color color, const Rectangle* clip)
+{
+  // The line sits outside of the rectangle
+  Command command = Command();
+  command.type = COMMAND_ROUNDED_LINES;
+  command.color = color;
+  command.rec = rec;
+  command.roundness = roundness;
+  command.lineThickness = lineThickness;
+  Record(command, { rec.x-lineThickness, rec.y-lineThickness, rec.width+lineThickness*2, rec.height+lineThickness*2 }, clip);
+}
+
+void GUI::TileRenderer::DrawTextEx(const Image& atlas, Font font, const char* text, Vector2 position, float fontSize, float spacing, Color tint, const Rectangle* clip)
+{
+  // Text is copied, the caller's string only has to live until this returns
+  Command command = Command();
+  command.type = COMMAND_TEXT;
+  command.color = tint;
+  command.rec = { position.x, position.y, fontSize, 0 };
+  command.lineThickness = spacing;
+  command.text = m_Text.size();
+  command.atlas = &atlas;
+  command.font = font;
+
+  m_Text.append(text);
+  m_Text.push_back('\0');
+  Record(command, GUI::Software::MeasureTextBounds(font, text, position, fontSize, spacing), clip);
+}
+
+void GUI::TileRenderer::DrawImage(const Image& source, Rectangle sourceRec, Rectangle dest, Color tint, const Rectangle* clip)
+{
+  // The source image is not copied, it has to outlive Render
+  Command command = Command();
+  command.type = COMMAND_IMAGE;
+  command.color = tint;
+  command.rec = dest;
+  command.source = sourceRec;
+  command.atlas = &source;
+  Record(command, dest, clip);
+}
+
+void GUI::TileRenderer::Clear(void) noexcept
+{
+  m_Commands.clear();
+  m_Text.clear();
+}
+
+void GUI::TileRenderer::Bin(const Image& image)
+{
+  m_Columns = (image.width+m_TileSize-1)/m_TileSize;
+  m_Rows = (image.height+m_TileSize-1)/m_TileSize;
+
+  // Bins keep their capacity between frames
+  size_t tileCount = (size_t)m_Columns*m_Rows;
+  if (m_Bins.size() < tileCount)
+    m_Bins.resize(tileCount);
+  for (size_t i = 0; i < tileCount; i++)
+    m_Bins[i].clear();
+
+  size_t binned = 0;
+  for (size_t i = 0; i < m_Commands.size(); i++)
+  {
+    const Command& command = m_Commands[i];
+    Rectangle bounds = command.clipped ? Intersect(command.bounds, command.clip) : command.bounds;
+    if (bounds.width <= 0 || bounds.height <= 0)
+      continue;
+
+    // Same whole pixel rounding as the rasterizer, so a command lands in every tile it touches and no other
+    int x0 = (int)floorf(bounds.x);
+    int y0 = (int)floorf(bounds.y);
+    int x1 = (int)ceilf(bounds.x+bounds.width);
+    int y1 = (int)ceilf(bounds.y+bounds.height);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > image.width) x1 = image.width;
+    if (y1 > image.height) y1 = image.height;
+    if (x1 <= x0 || y1 <= y0)
+      continue;
+
+    for (int row = y0/m_TileSize; row <= (y1-1)/m_TileSize; row++)
+    {
+      for (int column = x0/m_TileSize; column <= (x1-1)/m_TileSize; column++)
+      {
+        m_Bins[(size_t)row*m_Columns+column].push_back(i);
+        binned++;
+      }
+    }
+  }
+
+  m_Stats.tileCount = tileCount;
+  m_Stats.commandCount = m_Commands.size();
+  m_Stats.binnedCount = binned;
+}
+
+void GUI::TileRenderer::RenderTile(Image& image, size_t tile) noexcept
+{
+  const std::vector<uint32_t>& bin = m_Bins[tile];
+  if (bin.empty())
+    return;
+
+  auto start = std::chrono::steady_clock::now();
+
+  // Tiles never share pixels, so they are drawn without any locking
+  Rectangle tileBounds = { (float)((int)(tile%m_Columns)*m_TileSize), (float)((int)(tile/m_Columns)*m_TileSize), (float)m_TileSize, (float)m_TileSize };
+  for (uint32_t index : bin)
+  {
+    const Command& command = m_Commands[index];
+    Rectangle clip = command.clipped ? Intersect(tileBounds, command.clip) : tileBounds;
+
+    switch (command.type)
+    {
+      case COMMAND_RECTANGLE:
+        GUI::Software::DrawRectangle(image, command.rec, command.color, &clip);
+        break;
+      case COMMAND_ROUNDED:
+        GUI::Software::DrawRectangleRounded(image, command.rec, command.roundness, command.color, &clip);
+        break;
+      case COMMAND_ROUNDED_LINES:
+        GUI::Software::DrawRectangleRoundedLines(image, command.rec, command.roundness, command.lineThickness, command.color, &clip);
+        break;
+      case COMMAND_TEXT:
+        GUI::Software::DrawTextEx(image, *command.atlas, command.font, m_Text.c_str()+command.text, { command.rec.x, command.rec.y }, command.rec.width, command.lineThickness, command.color, &clip);
+        break;
+      case COMMAND_IMAGE:
+        GUI::Software::DrawImage(image, *command.atlas, command.source, command.rec, command.color, &clip);
+        break;
+    }
+  }
+
+  m_TileTimes[tile] = Milliseconds(start, std::chrono::steady_clock::now());
+}
+
+void GUI::TileRenderer::Render(Image& image, GUI::ThreadPool* pool)
+{
+  auto start = std::chrono::steady_clock::now();
+  Bin(image);
+  auto binned = std::chrono::steady_clock::now();
+
+  size_t tileCount = m_Stats.tileCount;
+  m_TileTimes.assign(tileCount, 0);
+
+  // Workers pull tiles from a shared counter, so a few expensive tiles never leave the other cores idle
+  std::atomic<size_t> nextTile(0);
+  auto work = [this, &image, &nextTile, tileCount]
+  {
+    for (size_t tile = nextTile++; tile < tileCount; tile = nextTile++)
+      RenderTile(image, tile);
+  };
+
+  size_t threadCount = pool ? pool->GetThreadCount() : 1;
+  if (threadCount > tileCount)
+    threadCount = tileCount;
+
+  if (threadCount > 1)
+  {
+    for (size_t i = 0; i < threadCount; i++)
+      pool->Submit(work);
+    pool->Wait();
+  }
+  else
+  {
+    work();
+  }
+
+  m_Stats.threadCount = threadCount ? threadCount : 1;
+  m_Stats.binMilliseconds = Milliseconds(start, binned);
+  m_Stats.renderMilliseconds = Milliseconds(binned, std::chrono::steady_clock::now());
+  m_Stats.activeTileCount = 0;
+  m_Stats.maxTileMilliseconds = 0;
+
+  float total = 0;
+  for (size_t i = 0; i < tileCount; i++)
+  {
+    if (m_Bins[i].empty())
+      continue;
+
+    m_Stats.activeTileCount++;
+    total += m_TileTimes[i];
+    if (m_TileTimes[i] > m_Stats.maxTileMilliseconds)
+      m_Stats.maxTileMilliseconds = m_TileTimes[i];
+  }
+  m_Stats.averageTileMilliseconds = m_Stats.activeTileCount ? total/m_Stats.activeTileCount : 0;
+}
+
+const GUI::TileStats& GUI::TileRenderer::GetStats(void) const noexcept
+{
+  return m_Stats;
+}
+
+const std::vector<float>& GUI::TileRenderer::GetTileTimes(void) const noexcept
+{
+  return m_TileTimes;
+}
+
+int GUI::TileRenderer::GetTileSize(void) const noexcept
+{
+  return m_TileSize;
+}
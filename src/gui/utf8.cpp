@@ -0,0 +1,189 @@
+#include "../../include/gui.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// The vector loads may read past the terminator within the same aligned block
+#if defined(__GNUC__)
+#define GUI_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define GUI_NO_SANITIZE_ADDRESS
+#endif
+
+// Length of the well formed sequence at text, 0 when it is invalid or truncated
+static size_t SequenceLength(const unsigned char* text) noexcept
+{
+  unsigned char lead = text[0];
+
+  if (lead >= 0xC2 && lead <= 0xDF)
+    return (text[1] & 0xC0) == 0x80 ? 2 : 0;
+
+  if (lead >= 0xE0 && lead <= 0xEF)
+  {
+    unsigned char low = lead == 0xE0 ? 0xA0 : 0x80;
+    unsigned char high = lead == 0xED ? 0x9F : 0xBF;
+    if (text[1] < low || text[1] > high)
+      return 0;
+    return (text[2] & 0xC0) == 0x80 ? 3 : 0;
+  }
+
+  if (lead >= 0xF0 && lead <= 0xF4)
+  {
+    unsigned char low = lead == 0xF0 ? 0x90 : 0x80;
+    unsigned char high = lead == 0xF4 ? 0x8F : 0xBF;
+    if (text[1] < low || text[1] > high)
+      return 0;
+    if ((text[2] & 0xC0) != 0x80)
+      return 0;
+    return (text[3] & 0xC0) == 0x80 ? 4 : 0;
+  }
+
+  return 0;
+}
+
+// Number of leading bytes that are printable ASCII, checked a whole vector at a time
+GUI_NO_SANITIZE_ADDRESS static size_t PrintableRun(const unsigned char* text, size_t limit) noexcept
+{
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  // Aligned loads never cross into the next page, so reading past the terminator is safe
+  while (i < limit && ((uintptr_t)(text+i) & 31))
+  {
+    if (text[i] < 0x20 || text[i] >= 0x7F)
+      return i;
+    i++;
+  }
+
+  const __m256i space = _mm256_set1_epi8(0x20);
+  const __m256i del = _mm256_set1_epi8(0x7F);
+  while (i+32 <= limit)
+  {
+    __m256i block = _mm256_load_si256((const __m256i*)(text+i));
+    __m256i special = _mm256_or_si256(_mm256_cmpgt_epi8(space, block), _mm256_cmpeq_epi8(block, del));
+    if (_mm256_movemask_epi8(special))
+      break;
+    i += 32;
+  }
+#elif defined(__SSE2__) || defined(_M_X64)
+  while (i < limit && ((uintptr_t)(text+i) & 15))
+  {
+    if (text[i] < 0x20 || text[i] >= 0x7F)
+      return i;
+    i++;
+  }
+
+  // Bytes >= 0x80 are negative as signed bytes, so one compare catches controls, NUL and non ASCII
+  const __m128i space = _mm_set1_epi8(0x20);
+  const __m128i del = _mm_set1_epi8(0x7F);
+  while (i+16 <= limit)
+  {
+    __m128i block = _mm_load_si128((const __m128i*)(text+i));
+    __m128i special = _mm_or_si128(_mm_cmplt_epi8(block, space), _mm_cmpeq_epi8(block, del));
+    if (_mm_movemask_epi8(special))
+      break;
+    i += 16;
+  }
+#endif
+
+  while (i < limit && text[i] >= 0x20 && text[i] < 0x7F)
+    i++;
+
+  return i;
+}
+
+size_t GUI::Utf8::CountCodepoints(const char* text, size_t length) noexcept
+{
+  size_t count = 0;
+  for (size_t i = 0; i < length; i++)
+  {
+    if ((text[i] & 0xC0) != 0x80)
+      count++;
+  }
+
+  return count;
+}
+
+size_t GUI::Utf8::PreviousCodepoint(const char* text, size_t index) noexcept
+{
+  // Continuation bytes never start a codepoint, so the caret steps over them
+  while (index && (text[--index] & 0xC0) == 0x80);
+  return index;
+}
+
+size_t GUI::Utf8::NextCodepoint(const char* text, size_t length, size_t index) noexcept
+{
+  if (index < length)
+    index++;
+  while (index < length && (text[index] & 0xC0) == 0x80)
+    index++;
+
+  return index;
+}
+
+size_t GUI::Utf8::Sanitize(const char* text, size_t maxBytes, size_t maxCodepoints, std::string& out) noexcept
+{
+  // Reads at most maxBytes of the source, so a huge clipboard is never scanned past the limit
+  const unsigned char* source = (const unsigned char*)text;
+  size_t start = out.length();
+  size_t codepoints = 0;
+  size_t i = 0;
+
+  while (codepoints < maxCodepoints && out.length()-start < maxBytes)
+  {
+    size_t budget = maxBytes-(out.length()-start);
+    if (maxCodepoints-codepoints < budget)
+      budget = maxCodepoints-codepoints;
+
+    size_t run = PrintableRun(source+i, budget);
+    if (run)
+    {
+      out.append(text+i, run);
+      codepoints += run;
+      i += run;
+      continue;
+    }
+
+    unsigned char c = source[i];
+    if (!c)
+      break;
+
+    if (c < 0x80)
+    {
+      // Line breaks and tabs become a single space, other control characters are dropped
+      if (c == '\r' && source[i+1] == '\n')
+        i++;
+      if (c == '\n' || c == '\r' || c == '\t')
+      {
+        out += ' ';
+        codepoints++;
+      }
+      i++;
+      continue;
+    }
+
+    size_t length = SequenceLength(source+i);
+    if (!length)
+    {
+      // Malformed bytes are replaced with U+FFFD
+      if (maxBytes-(out.length()-start) < 3)
+        break;
+      out.append("\xEF\xBF\xBD", 3);
+      codepoints++;
+      i++;
+      continue;
+    }
+
+    if (length > maxBytes-(out.length()-start))
+      break;
+
+    out.append(text+i, length);
+    codepoints++;
+    i += length;
+  }
+
+  return out.length()-start;
+}
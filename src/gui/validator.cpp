@@ -0,0 +1,444 @@
+#include "../../include/gui.hpp"
+
+#include <algorithm>
+#include <map>
+
+namespace
+{
+  enum PatternNodes : uint8_t
+  {
+    PATTERN_NODE_SET = 0,
+    PATTERN_NODE_CONCAT,
+    PATTERN_NODE_ALTERNATE,
+    PATTERN_NODE_REPEAT,
+  };
+
+  struct ByteSet
+  {
+    uint64_t bits[4];
+
+    void Add(unsigned char c) noexcept { bits[c >> 6] |= (uint64_t)1 << (c & 63); }
+    bool Has(unsigned char c) const noexcept { return (bits[c >> 6] >> (c & 63)) & 1; }
+  };
+
+  struct PatternNode
+  {
+    uint8_t type;
+    ByteSet set;
+    int min;
+    int max;
+    std::vector<PatternNode> children;
+  };
+
+  struct NfaState
+  {
+    std::vector<std::pair<ByteSet, int>> edges;
+    std::vector<int> epsilon;
+  };
+
+  constexpr size_t MAX_DFA_STATES = 4096;
+
+  // Recursive descent over the pattern subset: literals, . [] \d \w \s ( ) | * + ? {m} {m,} {m,n}
+  class PatternParser
+  {
+  public:
+    PatternParser(const char* pattern) : m_Pattern(pattern), m_Error(false) { }
+
+    bool Parse(PatternNode& root)
+    {
+      root = ParseAlternate();
+      return !m_Error && !*m_Pattern;
+    }
+
+  private:
+    const char* m_Pattern;
+    bool m_Error;
+
+  private:
+    static PatternNode MakeSet(void)
+    {
+      PatternNode node = PatternNode();
+      node.type = PATTERN_NODE_SET;
+      return node;
+    }
+
+    static void AddEscape(ByteSet& set, char c)
+    {
+      switch (c)
+      {
+        case 'd':
+          for (int i = '0'; i <= '9'; i++) set.Add(i);
+          break;
+        case 'w':
+          for (int i = '0'; i <= '9'; i++) set.Add(i);
+          for (int i = 'a'; i <= 'z'; i++) set.Add(i);
+          for (int i = 'A'; i <= 'Z'; i++) set.Add(i);
+          set.Add('_');
+          break;
+        case 's':
+          set.Add(' ');
+          set.Add('\t');
+          break;
+        default:
+          set.Add(c);
+      }
+    }
+
+    PatternNode ParseAlternate(void)
+    {
+      PatternNode first = ParseConcat();
+      if (*m_Pattern != '|')
+        return first;
+
+      PatternNode node = PatternNode();
+      node.type = PATTERN_NODE_ALTERNATE;
+      node.children.push_back(first);
+      while (*m_Pattern == '|')
+      {
+        m_Pattern++;
+        node.children.push_back(ParseConcat());
+      }
+
+      return node;
+    }
+
+    PatternNode ParseConcat(void)
+    {
+      PatternNode node = PatternNode();
+      node.type = PATTERN_NODE_CONCAT;
+      while (*m_Pattern && *m_Pattern != '|' && *m_Pattern != ')' && !m_Error)
+        node.children.push_back(ParseRepeat());
+
+      return node;
+    }
+
+    PatternNode ParseRepeat(void)
+    {
+      PatternNode atom = ParseAtom();
+
+      for (;;)
+      {
+        int min;
+        int max;
+        if (*m_Pattern == '*') { min = 0; max = -1; m_Pattern++; }
+        else if (*m_Pattern == '+') { min = 1; max = -1; m_Pattern++; }
+        else if (*m_Pattern == '?') { min = 0; max = 1; m_Pattern++; }
+        else if (*m_Pattern == '{')
+        {
+          if (!ParseCount(min, max))
+          {
+            m_Error = true;
+            return atom;
+          }
+        }
+        else return atom;
+
+        PatternNode node = PatternNode();
+        node.type = PATTERN_NODE_REPEAT;
+        node.min = min;
+        node.max = max;
+        node.children.push_back(atom);
+        atom = node;
+      }
+    }
+
+    bool ParseCount(int& min, int& max)
+    {
+      m_Pattern++;
+      if (*m_Pattern < '0' || *m_Pattern > '9')
+        return false;
+
+      min = 0;
+      while (*m_Pattern >= '0' && *m_Pattern <= '9')
+        min = min*10+(*m_Pattern++-'0');
+
+      max = min;
+      if (*m_Pattern == ',')
+      {
+        m_Pattern++;
+        max = -1;
+        if (*m_Pattern >= '0' && *m_Pattern <= '9')
+        {
+          max = 0;
+          while (*m_Pattern >= '0' && *m_Pattern <= '9')
+            max = max*10+(*m_Pattern++-'0');
+        }
+      }
+
+      if (*m_Pattern != '}' || (max != -1 && max < min) || min > 255 || max > 255)
+        return false;
+
+      m_Pattern++;
+      return true;
+    }
+
+    PatternNode ParseAtom(void)
+    {
+      PatternNode node = MakeSet();
+      char c = *m_Pattern++;
+
+      switch (c)
+      {
+        case '(':
+          node = ParseAlternate();
+          if (*m_Pattern == ')')
+            m_Pattern++;
+          else
+            m_Error = true;
+          return node;
+        case '[':
+          ParseClass(node.set);
+          return node;
+        case '.':
+          for (int i = 1; i < 256; i++) node.set.Add(i);
+          return node;
+        case '\\':
+          if (!*m_Pattern)
+            m_Error = true;
+          else
+            AddEscape(node.set, *m_Pattern++);
+          return node;
+        case '*': case '+': case '?': case '{': case ')':
+          m_Error = true;
+          return node;
+        default:
+          node.set.Add(c);
+          return node;
+      }
+    }
+
+    void ParseClass(ByteSet& set)
+    {
+      bool negate = *m_Pattern == '^';
+      if (negate)
+        m_Pattern++;
+
+      ByteSet members = ByteSet();
+      bool first = true;
+      while (*m_Pattern && (*m_Pattern != ']' || first))
+      {
+        first = false;
+        unsigned char low = *m_Pattern++;
+        if (low == '\\' && *m_Pattern)
+        {
+          AddEscape(members, *m_Pattern++);
+          continue;
+        }
+
+        if (*m_Pattern == '-' && m_Pattern[1] && m_Pattern[1] != ']')
+        {
+          unsigned char high = m_Pattern[1];
+          m_Pattern += 2;
+          for (int i = low; i <= high; i++)
+            members.Add(i);
+          continue;
+        }
+
+        members.Add(low);
+      }
+
+      if (*m_Pattern != ']')
+      {
+        m_Error = true;
+        return;
+      }
+      m_Pattern++;
+
+      for (int i = 1; i < 256; i++)
+      {
+        if (members.Has(i) != negate)
+          set.Add(i);
+      }
+    }
+  };
+
+  // Thompson construction, returns the state reached after matching the node
+  int Emit(std::vector<NfaState>& nfa, const PatternNode& node, int in)
+  {
+    switch (node.type)
+    {
+      case PATTERN_NODE_SET:
+      {
+        nfa.push_back(NfaState());
+        int out = nfa.size()-1;
+        nfa[in].edges.push_back({ node.set, out });
+        return out;
+      }
+      case PATTERN_NODE_CONCAT:
+      {
+        for (const PatternNode& child : node.children)
+          in = Emit(nfa, child, in);
+        return in;
+      }
+      case PATTERN_NODE_ALTERNATE:
+      {
+        nfa.push_back(NfaState());
+        int out = nfa.size()-1;
+        for (const PatternNode& child : node.children)
+        {
+          nfa.push_back(NfaState());
+          int start = nfa.size()-1;
+          nfa[in].epsilon.push_back(start);
+          nfa[Emit(nfa, child, start)].epsilon.push_back(out);
+        }
+        return out;
+      }
+      default:
+      {
+        for (int i = 0; i < node.min; i++)
+          in = Emit(nfa, node.children[0], in);
+
+        if (node.max < 0)
+        {
+          nfa.push_back(NfaState());
+          int loop = nfa.size()-1;
+          nfa[in].epsilon.push_back(loop);
+          nfa[Emit(nfa, node.children[0], loop)].epsilon.push_back(loop);
+          return loop;
+        }
+
+        for (int i = node.min; i < node.max; i++)
+        {
+          nfa.push_back(NfaState());
+          int skip = nfa.size()-1;
+          nfa[in].epsilon.push_back(skip);
+          nfa[Emit(nfa, node.children[0], in)].epsilon.push_back(skip);
+          in = skip;
+        }
+        return in;
+      }
+    }
+  }
+
+  void Closure(const std::vector<NfaState>& nfa, std::vector<int>& states)
+  {
+    for (size_t i = 0; i < states.size(); i++)
+    {
+      for (int next : nfa[states[i]].epsilon)
+      {
+        if (std::find(states.begin(), states.end(), next) == states.end())
+          states.push_back(next);
+      }
+    }
+
+    std::sort(states.begin(), states.end());
+  }
+}
+
+GUI::Validator::Validator(void)
+  : m_ClassCount(0)
+{ }
+
+GUI::Validator::Validator(const char* pattern)
+  : m_ClassCount(0)
+{
+  Compile(pattern);
+}
+
+bool GUI::Validator::Compile(const char* pattern)
+{
+  m_Transitions.clear();
+  m_Accepting.clear();
+  m_ClassCount = 0;
+
+  PatternNode root;
+  PatternParser parser(pattern);
+  if (!parser.Parse(root))
+  {
+    TraceLog(LOG_WARNING, "GUI: Invalid validator pattern \"%s\"", pattern);
+    return false;
+  }
+
+  std::vector<NfaState> nfa(1);
+  int match = Emit(nfa, root, 0);
+
+  // Bytes that no pattern set tells apart share a column of the transition table
+  std::vector<ByteSet> sets;
+  for (const NfaState& state : nfa)
+  {
+    for (const std::pair<ByteSet, int>& edge : state.edges)
+      sets.push_back(edge.first);
+  }
+
+  std::map<std::vector<bool>, uint8_t> signatures;
+  uint8_t representatives[256];
+  for (int c = 0; c < 256; c++)
+  {
+    std::vector<bool> signature(sets.size());
+    for (size_t i = 0; i < sets.size(); i++)
+      signature[i] = sets[i].Has(c);
+
+    std::map<std::vector<bool>, uint8_t>::iterator found = signatures.find(signature);
+    if (found == signatures.end())
+    {
+      representatives[m_ClassCount] = c;
+      found = signatures.insert({ signature, (uint8_t)m_ClassCount++ }).first;
+    }
+    m_ByteClasses[c] = found->second;
+  }
+
+  // Subset construction, state 0 is the dead state and state 1 the start
+  std::map<std::vector<int>, uint16_t> ids;
+  std::vector<std::vector<int>> subsets(1);
+  ids[subsets[0]] = 0;
+
+  std::vector<int> start(1, 0);
+  Closure(nfa, start);
+  ids[start] = 1;
+  subsets.push_back(start);
+
+  for (size_t current = 0; current < subsets.size(); current++)
+  {
+    if (subsets.size() > MAX_DFA_STATES)
+    {
+      TraceLog(LOG_WARNING, "GUI: Validator pattern \"%s\" is too complex", pattern);
+      m_Transitions.clear();
+      m_Accepting.clear();
+      return false;
+    }
+
+    m_Accepting.push_back(std::find(subsets[current].begin(), subsets[current].end(), match) != subsets[current].end());
+    for (size_t byteClass = 0; byteClass < m_ClassCount; byteClass++)
+    {
+      std::vector<int> next;
+      for (int state : subsets[current])
+      {
+        for (const std::pair<ByteSet, int>& edge : nfa[state].edges)
+        {
+          if (edge.first.Has(representatives[byteClass]) && std::find(next.begin(), next.end(), edge.second) == next.end())
+            next.push_back(edge.second);
+        }
+      }
+      Closure(nfa, next);
+
+      std::map<std::vector<int>, uint16_t>::iterator found = ids.find(next);
+      if (found == ids.end())
+      {
+        found = ids.insert({ next, (uint16_t)subsets.size() }).first;
+        subsets.push_back(next);
+      }
+      m_Transitions.push_back(found->second);
+    }
+  }
+
+  return true;
+}
+
+bool GUI::Validator::IsCompiled(void) const noexcept
+{
+  return !m_Transitions.empty();
+}
+
+uint16_t GUI::Validator::Run(uint16_t state, const char* text, size_t length) const noexcept
+{
+  const unsigned char* bytes = (const unsigned char*)text;
+  for (size_t i = 0; i < length && state; i++)
+    state = m_Transitions[state*m_ClassCount+m_ByteClasses[bytes[i]]];
+
+  return state;
+}
+
+bool GUI::Validator::IsAccepting(uint16_t state) const noexcept
+{
+  return m_Accepting[state];
+}
@@ -0,0 +1,318 @@
+#include "../../include/gui.hpp"
+
+namespace
+{
+  enum WordClasses : uint8_t
+  {
+    WORD_CLASS_SPACE = 0,
+    WORD_CLASS_LETTER,
+    WORD_CLASS_HIRAGANA,
+    WORD_CLASS_KATAKANA,
+    WORD_CLASS_IDEOGRAPH,
+    WORD_CLASS_PUNCTUATION,
+    WORD_CLASS_JOINER,
+  };
+}
+
+// A reduced UAX #29 classification: letters and digits form words, hiragana and katakana runs each form words,
+// every ideograph is a word of its own and punctuation stops navigation
+static uint8_t Classify(int codepoint) noexcept
+{
+  if (codepoint < 0x80)
+  {
+    if (codepoint == ' ' || codepoint == '\t' || codepoint == '\n' || codepoint == '\r')
+      return WORD_CLASS_SPACE;
+    if ((codepoint >= 'a' && codepoint <= 'z') || (codepoint >= 'A' && codepoint <= 'Z') || (codepoint >= '0' && codepoint <= '9') || codepoint == '_')
+      return WORD_CLASS_LETTER;
+    if (codepoint == '\'' || codepoint == '.' || codepoint == ',' || codepoint == ':')
+      return WORD_CLASS_JOINER;
+    return WORD_CLASS_PUNCTUATION;
+  }
+
+  if (codepoint == 0xA0 || codepoint == 0x3000 || (codepoint >= 0x2000 && codepoint <= 0x200A) || codepoint == 0x202F || codepoint == 0x205F)
+    return WORD_CLASS_SPACE;
+  if (codepoint == 0x2019 || codepoint == 0xB7)
+    return WORD_CLASS_JOINER;
+  if ((codepoint >= 0xA1 && codepoint <= 0xBF && codepoint != 0xAA && codepoint != 0xB5 && codepoint != 0xBA) || codepoint == 0xD7 || codepoint == 0xF7)
+    return WORD_CLASS_PUNCTUATION;
+  if ((codepoint >= 0x2010 && codepoint <= 0x2064) || (codepoint >= 0x3001 && codepoint <= 0x303F) || (codepoint >= 0xFF01 && codepoint <= 0xFF0F) || (codepoint >= 0xFF1A && codepoint <= 0xFF20))
+    return WORD_CLASS_PUNCTUATION;
+  if (codepoint >= 0x3040 && codepoint <= 0x309F)
+    return WORD_CLASS_HIRAGANA;
+  if ((codepoint >= 0x30A0 && codepoint <= 0x30FF) || (codepoint >= 0x31F0 && codepoint <= 0x31FF) || (codepoint >= 0xFF66 && codepoint <= 0xFF9F))
+    return WORD_CLASS_KATAKANA;
+  if ((codepoint >= 0x3400 && codepoint <= 0x4DBF) || (codepoint >= 0x4E00 && codepoint <= 0x9FFF) || (codepoint >= 0xF900 && codepoint <= 0xFAFF) || (codepoint >= 0x20000 && codepoint <= 0x3FFFF))
+    return WORD_CLASS_IDEOGRAPH;
+
+  return WORD_CLASS_LETTER;
+}
+
+static uint8_t ClassAt(const std::string& text, size_t offset, size_t* next) noexcept
+{
+  int size;
+  int codepoint = GetCodepointNext(text.c_str()+offset, &size);
+  *next = offset+size;
+  return Classify(codepoint);
+}
+
+// End of the segment that starts at offset, and whether it is a word rather than whitespace
+static size_t SegmentEnd(const std::string& text, size_t offset, bool* word) noexcept
+{
+  size_t next;
+  uint8_t type = ClassAt(text, offset, &next);
+  *word = type != WORD_CLASS_SPACE;
+
+  if (type == WORD_CLASS_IDEOGRAPH || type == WORD_CLASS_PUNCTUATION || type == WORD_CLASS_JOINER)
+    return next;
+
+  while (next < text.length())
+  {
+    size_t after;
+    uint8_t nextType = ClassAt(text, next, &after);
+
+    // Joiners such as the apostrophe in "can't" or the dot in "3.14" only bind between letters
+    if (type == WORD_CLASS_LETTER && nextType == WORD_CLASS_JOINER && after < text.length())
+    {
+      size_t afterJoiner;
+      if (ClassAt(text, after, &afterJoiner) != WORD_CLASS_LETTER)
+        break;
+      next = afterJoiner;
+      continue;
+    }
+
+    if (nextType != type)
+      break;
+    next = after;
+  }
+
+  return next;
+}
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+static inline size_t HighestBit(uint64_t value) noexcept
+{
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return index;
+}
+
+static inline size_t LowestBit(uint64_t value) noexcept
+{
+  unsigned long index;
+  _BitScanForward64(&index, value);
+  return index;
+}
+#else
+static inline size_t HighestBit(uint64_t value) noexcept
+{
+  return 63-__builtin_clzll(value);
+}
+
+static inline size_t LowestBit(uint64_t value) noexcept
+{
+  return __builtin_ctzll(value);
+}
+#endif
+
+static inline bool TestBit(const std::vector<uint64_t>& bits, size_t index) noexcept
+{
+  return (bits[index >> 6] >> (index & 63)) & 1;
+}
+
+static inline void AssignBit(std::vector<uint64_t>& bits, size_t index, bool value) noexcept
+{
+  if (value)
+    bits[index >> 6] |= (uint64_t)1 << (index & 63);
+  else
+    bits[index >> 6] &= ~((uint64_t)1 << (index & 63));
+}
+
+static uint64_t ReadBits(const std::vector<uint64_t>& bits, size_t index, size_t count) noexcept
+{
+  size_t word = index >> 6;
+  size_t shift = index & 63;
+  uint64_t value = bits[word] >> shift;
+  if (shift && shift+count > 64)
+    value |= bits[word+1] << (64-shift);
+
+  return count == 64 ? value : value & (((uint64_t)1 << count)-1);
+}
+
+static void WriteBits(std::vector<uint64_t>& bits, size_t index, size_t count, uint64_t value) noexcept
+{
+  for (size_t i = 0; i < count;)
+  {
+    size_t word = (index+i) >> 6;
+    size_t shift = (index+i) & 63;
+    size_t chunk = 64-shift < count-i ? 64-shift : count-i;
+    uint64_t mask = (chunk == 64 ? ~(uint64_t)0 : (((uint64_t)1 << chunk)-1)) << shift;
+
+    bits[word] = (bits[word] & ~mask) | (((value >> i) << shift) & mask);
+    i += chunk;
+  }
+}
+
+// memmove for bit ranges, 64 bits at a time
+static void MoveBits(std::vector<uint64_t>& bits, size_t destination, size_t source, size_t count) noexcept
+{
+  if (destination < source)
+  {
+    for (size_t i = 0; i < count; i += 64)
+    {
+      size_t chunk = count-i < 64 ? count-i : 64;
+      WriteBits(bits, destination+i, chunk, ReadBits(bits, source+i, chunk));
+    }
+  }
+  else if (destination > source)
+  {
+    for (size_t i = count; i > 0;)
+    {
+      size_t chunk = i < 64 ? i : 64;
+      i -= chunk;
+      WriteBits(bits, destination+i, chunk, ReadBits(bits, source+i, chunk));
+    }
+  }
+}
+
+static size_t FindPrevious(const std::vector<uint64_t>& bits, size_t index) noexcept
+{
+  // Last set bit strictly below index
+  while (index)
+  {
+    index--;
+    uint64_t word = bits[index >> 6] & (~(uint64_t)0 >> (63-(index & 63)));
+    if (word)
+      return (index & ~(size_t)63)+HighestBit(word);
+    index &= ~(size_t)63;
+  }
+
+  return 0;
+}
+
+static size_t FindNext(const std::vector<uint64_t>& bits, size_t index, size_t limit) noexcept
+{
+  // First set bit strictly above index, limit when there is none
+  for (index++; index < limit; index = (index | 63)+1)
+  {
+    uint64_t word = bits[index >> 6] & (~(uint64_t)0 << (index & 63));
+    if (word)
+    {
+      size_t found = (index & ~(size_t)63)+LowestBit(word);
+      return found < limit ? found : limit;
+    }
+  }
+
+  return limit;
+}
+
+GUI::WordIndex::WordIndex(void)
+  : m_Length(0)
+{
+  m_Boundaries.assign(1, 1);
+  m_WordStarts.assign(1, 0);
+}
+
+void GUI::WordIndex::Resize(size_t length) noexcept
+{
+  size_t words = (length >> 6)+1;
+  m_Boundaries.resize(words, 0);
+  m_WordStarts.resize(words, 0);
+  m_Length = length;
+}
+
+void GUI::WordIndex::Rebuild(const std::string& text) noexcept
+{
+  m_Boundaries.clear();
+  m_WordStarts.clear();
+  Resize(text.length());
+  Segment(text, 0, 0, true);
+}
+
+void GUI::WordIndex::Update(const std::string& text, size_t offset, size_t removed, size_t inserted) noexcept
+{
+  size_t oldLength = m_Length;
+
+  // Shift everything after the edit, bit m_Length marks the end of the text
+  if (inserted > removed)
+  {
+    Resize(text.length());
+    MoveBits(m_Boundaries, offset+inserted, offset+removed, oldLength+1-(offset+removed));
+    MoveBits(m_WordStarts, offset+inserted, offset+removed, oldLength+1-(offset+removed));
+  }
+  else if (inserted < removed)
+  {
+    MoveBits(m_Boundaries, offset+inserted, offset+removed, oldLength+1-(offset+removed));
+    MoveBits(m_WordStarts, offset+inserted, offset+removed, oldLength+1-(offset+removed));
+    Resize(text.length());
+    if ((m_Length+1) & 63)
+    {
+      WriteBits(m_Boundaries, m_Length+1, 64-((m_Length+1) & 63), 0);
+      WriteBits(m_WordStarts, m_Length+1, 64-((m_Length+1) & 63), 0);
+    }
+  }
+
+  // Re-segment from two boundaries back, joiners can merge the word before the edit
+  size_t start = FindPrevious(m_Boundaries, FindPrevious(m_Boundaries, offset));
+  Segment(text, start, offset+inserted, false);
+}
+
+void GUI::WordIndex::Segment(const std::string& text, size_t start, size_t editEnd, bool full) noexcept
+{
+  AssignBit(m_Boundaries, start, true);
+
+  for (size_t offset = start; offset < m_Length;)
+  {
+    bool word;
+    size_t end = SegmentEnd(text, offset, &word);
+    bool converged = !full && end >= editEnd && TestBit(m_Boundaries, end) && end < m_Length;
+
+    AssignBit(m_WordStarts, offset, word);
+    for (size_t i = offset+1; i < end; i++)
+    {
+      AssignBit(m_Boundaries, i, false);
+      AssignBit(m_WordStarts, i, false);
+    }
+    AssignBit(m_Boundaries, end, true);
+
+    // Past the edit the old boundaries are valid again once a segment lines up with them
+    if (converged)
+      return;
+    offset = end;
+  }
+
+  AssignBit(m_WordStarts, m_Length, false);
+}
+
+size_t GUI::WordIndex::PreviousWordStart(size_t index) const noexcept
+{
+  return FindPrevious(m_WordStarts, index);
+}
+
+size_t GUI::WordIndex::NextWordEnd(size_t index) const noexcept
+{
+  size_t end = FindNext(m_Boundaries, index, m_Length);
+  if (end < m_Length && !TestBit(m_WordStarts, FindPrevious(m_Boundaries, end)))
+    end = FindNext(m_Boundaries, end, m_Length);
+
+  return end;
+}
+
+void GUI::WordIndex::SegmentAt(size_t index, size_t& start, size_t& end) const noexcept
+{
+  if (index >= m_Length)
+  {
+    start = FindPrevious(m_Boundaries, m_Length);
+    end = m_Length;
+    return;
+  }
+
+  start = TestBit(m_Boundaries, index) ? index : FindPrevious(m_Boundaries, index);
+  end = FindNext(m_Boundaries, index, m_Length);
+}
+
+size_t GUI::WordIndex::GetMemoryUsage(void) const noexcept
+{
+  return (m_Boundaries.capacity()+m_WordStarts.capacity())*sizeof(uint64_t);
+}
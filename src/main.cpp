@@ -15,7 +15,9 @@ int main(void)
   int monitor = GetCurrentMonitor();
   float monitorWidth = GetMonitorWidth(monitor);
   float monitorHeight = GetMonitorHeight(monitor);
-  float scale = (float)monitorWidth/1000;
+
+  GUI::Context context;
+  float scale = context.GetScale();
 
   float scaledWindowWidth = windowWidth*scale;
   float scaledWindowHeight = windowHeight*scale;
@@ -23,9 +25,23 @@ int main(void)
   SetWindowSize(scaledWindowWidth, scaledWindowHeight);
   SetWindowPosition((monitorWidth/2)-(scaledWindowWidth/2), (monitorHeight/2)-(scaledWindowHeight/2));
 
+  GUI::Animator animator;
+  GUI::ClipStack clip;
+  GUI::TextBatcher textBatcher;
+  GUI::FocusManager focus;
+  GUI::EventQueue events;
+  // Shared by the inputs given it through SetAutocomplete
+  GUI::Autocomplete autocomplete;
   GUI::MouseState mouseState = { 0 };
+  mouseState.animator = &animator;
+  mouseState.clip = &clip;
+  mouseState.textBatcher = &textBatcher;
+  mouseState.focus = &focus;
+  mouseState.events = &events;
+
+  GUI::ImContext ui;
 
-  // Setup GUI styles here
+  // Setup GUI styles here, in unscaled units with fonts from context.LoadFont()
   // ---------------------------
   
 
@@ -34,18 +50,45 @@ int main(void)
 
   while (!WindowShouldClose())
   {
+    GUI::Stats::BeginFrame();
+    animator.Update(GetFrameTime());
+    // Publishes suggestions the worker finished since the last frame
+    autocomplete.Update();
+
+    if (context.Update())
+    {
+      // Re-apply context.Scale() to the styles and bounds of the components here, the old fonts are unloaded on the next Update
+    }
+
     mouseState.position = GetMousePosition();
     mouseState.clicked = false;
+    mouseState.pressed = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
+    mouseState.down = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
     mouseState.cursor = MOUSE_CURSOR_DEFAULT;
     SetMouseCursor(mouseState.cursor);
+    focus.BeginFrame();
 
     BeginDrawing();
     ClearBackground(BLACK);
+    ui.BeginFrame(mouseState);
 
-    // Update and render GUI components here
+    // Update and render GUI components here, GUI::Im widgets take the ui context
     // -----------------------------------------
 
+    ui.EndFrame();
+    focus.EndFrame(mouseState);
+    events.Dispatch();
+    textBatcher.Flush();
+
+    // Sleep until the next input event unless a transition, a held key repeating in an input or a suggestion lookup still needs frames
+    if (animator.GetNextWakeup() > 0 && !ui.IsAnimating() && !autocomplete.IsPending())
+      EnableEventWaiting();
+    else
+      DisableEventWaiting();
+
     EndDrawing();
+
+    GUI::Stats::EndFrame();
   }
 
   CloseWindow();
@@ -0,0 +1,273 @@
+// Drives a Button and an Input through idle, hover and typing frames and fails if any frame after warm-up allocates
+//
+//   allocations [frames]
+//   allocations 10000
+//
+// Built by GUI_BUILD_TESTS, which compiles the GUI into it with GUI_COUNT_ALLOCATIONS so every operator new is counted.
+// raylib needs a GL context for the draw calls, the window is hidden and the test is skipped where none can be opened.
+// The text buffers only grow past their previous length, so one warm-up cycle of idle and hover reaches the steady state.
+// The undo journal grows until it reaches its limit, typing warms up with a small limit for enough cycles to fill it.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <new>
+
+#include "../include/gui.hpp"
+
+namespace
+{
+  constexpr int EXIT_SKIPPED = 77;
+  constexpr float FRAME_TIME = 1.0f/60;
+  constexpr int HOVER_PERIOD = 30;
+  constexpr size_t UNDO_LIMIT = 4096;
+  constexpr int TYPING_WARMUP_CYCLES = 16;
+  constexpr const char* SENTENCE = "The quick brown fox jumps over the lazy dog, twice.";
+
+  constexpr Rectangle BUTTON_BOUNDS = { 20, 20, 160, 40 };
+  constexpr Rectangle INPUT_BOUNDS = { 20, 80, 300, 40 };
+  constexpr Vector2 OUTSIDE = { 400, 300 };
+}
+
+typedef struct FrameInput
+{
+  Vector2 position;
+  bool pressed;
+  int key;
+  int codepoint;
+} FrameInput;
+
+typedef FrameInput (*Scenario)(int frame);
+
+static Vector2 Center(Rectangle bounds)
+{
+  return { bounds.x+bounds.width/2, bounds.y+bounds.height/2 };
+}
+
+static FrameInput Idle(int frame)
+{
+  (void)frame;
+  return { OUTSIDE, false, KEY_NULL, 0 };
+}
+
+// Moves between the button, the input and empty space, so hover transitions and events run every few frames
+static FrameInput Hover(int frame)
+{
+  static const Vector2 stops[] = { Center(BUTTON_BOUNDS), OUTSIDE, Center(INPUT_BOUNDS), OUTSIDE };
+  return { stops[(frame/HOVER_PERIOD)%4], false, KEY_NULL, 0 };
+}
+
+// Types the sentence one codepoint a frame into the focused input, then backspaces all of it
+static FrameInput Typing(int frame)
+{
+  int length = (int)strlen(SENTENCE);
+  int step = frame%(length*2);
+  if (step < length)
+    return { Center(INPUT_BOUNDS), false, KEY_NULL, (unsigned char)SENTENCE[step] };
+
+  return { Center(INPUT_BOUNDS), false, KEY_BACKSPACE, 0 };
+}
+
+static GUI::ButtonStyle MakeButtonStyle(void)
+{
+  GUI::ButtonStyle style = GUI::ButtonStyle();
+  style.baseBackgroundColor = DARKGRAY;
+  style.baseTextColor = RAYWHITE;
+  style.baseOutlineColor = GRAY;
+  style.hoverBackgroundColor = GRAY;
+  style.hoverTextColor = WHITE;
+  style.hoverOutlineColor = LIGHTGRAY;
+  style.font = GetFontDefault();
+  style.fontSize = 20;
+  style.textAlignment = GUI::TEXT_ALIGNMENT_CENTER;
+  style.roundness = 0.5f;
+  style.outlineThickness = 2;
+  style.outlineDistance = 2;
+  style.hoverScale = 1.05f;
+  style.hoverOutlineOffset = 2;
+  style.transitionTime = 0.2f;
+  return style;
+}
+
+static GUI::InputStyle MakeInputStyle(void)
+{
+  GUI::InputStyle style = GUI::InputStyle();
+  style.baseBackgroundColor = DARKGRAY;
+  style.baseOutlineColor = GRAY;
+  style.baseTextColor = RAYWHITE;
+  style.basePlaceholderColor = GRAY;
+  style.hoverBackgroundColor = GRAY;
+  style.hoverOutlineColor = LIGHTGRAY;
+  style.hoverTextColor = WHITE;
+  style.hoverPlaceholderColor = LIGHTGRAY;
+  style.selectedBackgroundColor = BLACK;
+  style.selectedOutlineColor = SKYBLUE;
+  style.selectedTextColor = WHITE;
+  style.highlightColor = { 80, 120, 255, 100 };
+  style.font = GetFontDefault();
+  style.fontSize = 20;
+  style.roundness = 0.3f;
+  style.outlineThickness = 2;
+  style.outlineDistance = 2;
+  style.transitionTime = 0.2f;
+  return style;
+}
+
+class Harness
+{
+public:
+  Harness(void)
+    : m_MouseState(), m_Button(BUTTON_BOUNDS, MakeButtonStyle(), "Submit"), m_Input(INPUT_BOUNDS, MakeInputStyle(), "Search"), m_EventCount(0)
+  {
+    m_MouseState.animator = &m_Animator;
+    m_MouseState.clip = &m_Clip;
+    m_MouseState.textBatcher = &m_TextBatcher;
+    m_MouseState.focus = &m_Focus;
+    m_MouseState.events = &m_Events;
+
+    m_Input.SetUndoLimit(UNDO_LIMIT);
+
+    m_Events.AddHandler(GUI::EVENT_TEXT_CHANGED, nullptr, CountEvent, &m_EventCount);
+    m_Events.AddHandler(GUI::EVENT_HOVER_ENTER, nullptr, CountEvent, &m_EventCount);
+  }
+
+  // One frame in the order main.cpp runs it, returns the heap allocations it made
+  size_t Frame(const FrameInput& input)
+  {
+    GUI::Stats::BeginFrame();
+    m_Animator.Update(FRAME_TIME);
+
+    m_MouseState.position = input.position;
+    m_MouseState.clicked = false;
+    m_MouseState.pressed = input.pressed;
+    m_MouseState.down = input.pressed;
+    m_MouseState.cursor = MOUSE_CURSOR_DEFAULT;
+    m_Focus.BeginFrame();
+    m_Focus.PushKey(input.key);
+    m_Focus.PushChar(input.codepoint);
+
+    BeginDrawing();
+    ClearBackground(BLACK);
+    m_Button.UpdateAndRender(m_MouseState);
+    m_Input.UpdateAndRender(m_MouseState);
+    m_Focus.EndFrame(m_MouseState);
+    m_Events.Dispatch();
+    m_TextBatcher.Flush();
+    EndDrawing();
+
+    return GUI::Stats::EndFrame();
+  }
+
+  void Focus(void)
+  {
+    Frame({ Center(INPUT_BOUNDS), true, KEY_NULL, 0 });
+  }
+
+  size_t GetEventCount(void) const noexcept
+  {
+    return m_EventCount;
+  }
+
+private:
+  GUI::Animator m_Animator;
+  GUI::ClipStack m_Clip;
+  GUI::TextBatcher m_TextBatcher;
+  GUI::FocusManager m_Focus;
+  GUI::EventQueue m_Events;
+  GUI::MouseState m_MouseState;
+  GUI::Button m_Button;
+  GUI::Input m_Input;
+  size_t m_EventCount;
+
+private:
+  static void CountEvent(const GUI::Event& event, void* userData)
+  {
+    (void)event;
+    (*(size_t*)userData)++;
+  }
+};
+
+// Runs warmup unmeasured frames, then frames measured ones, and reports every frame that allocated
+static bool Run(Harness& harness, const char* name, Scenario scenario, int warmup, int frames)
+{
+  for (int frame = 0; frame < warmup; frame++)
+    harness.Frame(scenario(frame));
+
+  size_t failedFrames = 0;
+  size_t allocations = 0;
+  size_t bytes = 0;
+  int firstFailure = -1;
+  for (int frame = warmup; frame < warmup+frames; frame++)
+  {
+    size_t count = harness.Frame(scenario(frame));
+    if (!count)
+      continue;
+
+    if (firstFailure < 0)
+      firstFailure = frame-warmup;
+    failedFrames++;
+    allocations += count;
+    bytes += GUI::Stats::bytesThisFrame;
+  }
+
+  if (failedFrames)
+  {
+    printf("FAIL %-8s %zu of %d frames allocated, %zu allocations (%zu bytes), first at frame %d\n", name, failedFrames, frames, allocations, bytes, firstFailure);
+    return false;
+  }
+
+  printf("ok   %-8s %d frames without an allocation\n", name, frames);
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  int frames = argc > 1 ? atoi(argv[1]) : 5000;
+  if (frames <= 0)
+  {
+    fprintf(stderr, "usage: %s [frames]\n", argv[0]);
+    return 1;
+  }
+
+  // A call to operator new itself is never elided, so this proves the hooks are installed
+  size_t before = GUI::Stats::allocationsTotal;
+  void* volatile probe = ::operator new(16);
+  ::operator delete(probe);
+  if (GUI::Stats::allocationsTotal == before)
+  {
+    fprintf(stderr, "allocations: not built with GUI_COUNT_ALLOCATIONS, nothing would be counted\n");
+    return 1;
+  }
+
+  SetTraceLogLevel(LOG_WARNING);
+  SetConfigFlags(FLAG_WINDOW_HIDDEN);
+  InitWindow(400, 300, "allocations");
+  if (!IsWindowReady())
+  {
+    fprintf(stderr, "allocations: no window could be opened, skipped\n");
+    return EXIT_SKIPPED;
+  }
+
+  bool passed = true;
+  {
+    Harness harness;
+    int typingCycle = (int)strlen(SENTENCE)*2;
+
+    passed &= Run(harness, "idle", Idle, HOVER_PERIOD, frames);
+    passed &= Run(harness, "hover", Hover, HOVER_PERIOD*4, frames);
+
+    harness.Focus();
+    passed &= Run(harness, "typing", Typing, typingCycle*TYPING_WARMUP_CYCLES, frames);
+
+    // Counted events show the scenarios really drove the widgets
+    if (!harness.GetEventCount())
+    {
+      printf("FAIL no hover or text events were dispatched\n");
+      passed = false;
+    }
+  }
+
+  CloseWindow();
+  return passed ? 0 : 1;
+}
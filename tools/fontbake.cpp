@@ -0,0 +1,147 @@
+// Bakes glyph atlases and metrics for a font into a C++ source file holding GUI::bakedFonts
+//
+//   fontbake <font.ttf> <output.cpp> <sizes> <ranges>
+//   fontbake assets/fonts/opensans.ttf baked_fonts.cpp 16,24,32 32-126,160-255
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/gui.hpp"
+
+static bool ParseList(const char* text, std::vector<int>& values, bool ranges)
+{
+  for (const char* c = text; *c;)
+  {
+    char* end;
+    long first = strtol(c, &end, 10);
+    long last = first;
+    if (end == c)
+      return false;
+
+    if (ranges && *end == '-')
+    {
+      c = end+1;
+      last = strtol(c, &end, 10);
+      if (end == c || last < first)
+        return false;
+    }
+
+    for (long value = first; value <= last; value++)
+      values.push_back(value);
+
+    c = end;
+    if (*c == ',')
+      c++;
+    else if (*c)
+      return false;
+  }
+
+  return !values.empty();
+}
+
+static void Align(std::string& blob)
+{
+  while (blob.size() % 4)
+    blob.push_back('\0');
+}
+
+int main(int argc, char** argv)
+{
+  if (argc != 5)
+  {
+    fprintf(stderr, "usage: fontbake <font.ttf> <output.cpp> <sizes> <ranges>\n");
+    return 1;
+  }
+
+  std::vector<int> sizes;
+  std::vector<int> codepoints;
+  if (!ParseList(argv[3], sizes, false) || !ParseList(argv[4], codepoints, true))
+  {
+    fprintf(stderr, "fontbake: sizes are a comma separated list, ranges look like 32-126,160-255\n");
+    return 1;
+  }
+
+  SetTraceLogLevel(LOG_WARNING);
+  unsigned int fileSize = 0;
+  unsigned char* fileData = LoadFileData(argv[1], &fileSize);
+  if (!fileData)
+    return 1;
+
+  std::vector<GUI::FontBlobEntry> entries(sizes.size());
+  std::string blob(sizeof(GUI::FontBlobHeader)+entries.size()*sizeof(GUI::FontBlobEntry), '\0');
+
+  uint32_t name = blob.size();
+  blob.append(GetFileName(argv[1]));
+  blob.push_back('\0');
+
+  for (size_t i = 0; i < sizes.size(); i++)
+  {
+    // Same rasterization and packing as LoadFontEx, done once here instead of on every start
+    int padding = 4;
+    GlyphInfo* glyphs = LoadFontData(fileData, fileSize, sizes[i], codepoints.data(), codepoints.size(), FONT_DEFAULT);
+    if (!glyphs)
+    {
+      fprintf(stderr, "fontbake: cannot rasterize %s at %d\n", argv[1], sizes[i]);
+      return 1;
+    }
+
+    Rectangle* recs = nullptr;
+    Image atlas = GenImageFontAtlas(glyphs, &recs, codepoints.size(), sizes[i], padding, 0);
+    ImageFormat(&atlas, PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA);
+
+    GUI::FontBlobEntry& entry = entries[i];
+    entry.name = name;
+    entry.baseSize = sizes[i];
+    entry.glyphCount = codepoints.size();
+    entry.glyphPadding = padding;
+    entry.atlasWidth = atlas.width;
+    entry.atlasHeight = atlas.height;
+
+    Align(blob);
+    entry.glyphOffset = blob.size();
+    for (size_t j = 0; j < codepoints.size(); j++)
+    {
+      GUI::FontBlobGlyph glyph = { glyphs[j].value, glyphs[j].offsetX, glyphs[j].offsetY, glyphs[j].advanceX, recs[j] };
+      blob.append((const char*)&glyph, sizeof(glyph));
+    }
+
+    // Only coverage is stored, the gray channel is always white
+    entry.atlasOffset = blob.size();
+    const unsigned char* pixels = (const unsigned char*)atlas.data;
+    for (int j = 0; j < atlas.width*atlas.height; j++)
+      blob.push_back(pixels[j*2+1]);
+
+    UnloadImage(atlas);
+    MemFree(recs);
+    UnloadFontData(glyphs, codepoints.size());
+  }
+
+  UnloadFileData(fileData);
+
+  GUI::FontBlobHeader header = GUI::FontBlobHeader();
+  memcpy(header.magic, "GUIF", 4);
+  header.version = FONT_BLOB_VERSION;
+  header.fontCount = entries.size();
+  memcpy(&blob[0], &header, sizeof(header));
+  memcpy(&blob[sizeof(header)], entries.data(), entries.size()*sizeof(GUI::FontBlobEntry));
+
+  FILE* file = fopen(argv[2], "w");
+  if (!file)
+  {
+    fprintf(stderr, "fontbake: cannot write %s\n", argv[2]);
+    return 1;
+  }
+
+  fprintf(file, "// Generated by tools/fontbake from %s, do not edit\n\n", GetFileName(argv[1]));
+  fprintf(file, "#include <stddef.h>\n\nnamespace GUI\n{\n");
+  fprintf(file, "  extern const unsigned char bakedFonts[];\n  extern const size_t bakedFontsSize;\n\n");
+  fprintf(file, "  alignas(4) const unsigned char bakedFonts[] =\n  {");
+  for (size_t i = 0; i < blob.size(); i++)
+    fprintf(file, "%s0x%02x,", i % 16 ? " " : "\n    ", (unsigned char)blob[i]);
+  fprintf(file, "\n  };\n\n  const size_t bakedFontsSize = %zu;\n}\n", blob.size());
+
+  bool written = !ferror(file);
+  fclose(file);
+  return written ? 0 : 1;
+}
@@ -0,0 +1,319 @@
+// Compiles a text layout into the binary format read by GUI::Layout
+//
+//   # comment
+//   panel toolbar 0 0 800 60 style=toolbar {
+//     button save 10 10 100 40 style=primary "Save"
+//     label title 120 10 200 40 "Untitled"
+//   }
+//   input search 10 70 300 40 style=field "Search..."
+//
+// Child bounds are relative to their parent and are stored absolute.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <map>
+
+#include "../include/gui.hpp"
+
+namespace
+{
+  typedef struct Token
+  {
+    std::string text;
+    int line;
+    bool quoted;
+  } Token;
+
+  class Compiler
+  {
+  public:
+    Compiler(void)
+    {
+      m_Strings.push_back('\0');
+      InternStyle("default");
+    }
+
+    bool Parse(const std::string& source)
+    {
+      if (!Tokenize(source))
+        return false;
+
+      std::vector<uint32_t> stack;
+      for (size_t i = 0; i < m_Tokens.size();)
+      {
+        const Token& token = m_Tokens[i];
+        if (token.text == "}" && !token.quoted)
+        {
+          if (stack.empty())
+            return Error(token.line, "unexpected '}'");
+
+          m_Widgets[stack.back()].next = m_Widgets.size();
+          stack.pop_back();
+          i++;
+          continue;
+        }
+
+        if (!ParseWidget(i, stack))
+          return false;
+      }
+
+      if (!stack.empty())
+        return Error(m_Tokens.back().line, "missing '}'");
+
+      return true;
+    }
+
+    bool Write(const char* fileName)
+    {
+      std::vector<GUI::LayoutLookup> lookups(1);
+      while (lookups.size() < m_Widgets.size()*2)
+        lookups.resize(lookups.size()*2);
+      lookups.assign(lookups.size(), GUI::LayoutLookup());
+
+      uint32_t mask = lookups.size()-1;
+      for (size_t i = 0; i < m_Widgets.size(); i++)
+      {
+        uint32_t hash = HashId(&m_Strings[m_Widgets[i].id]);
+        uint32_t slot = hash & mask;
+        while (lookups[slot].hash)
+          slot = (slot+1) & mask;
+        lookups[slot] = { hash, (uint32_t)i };
+      }
+
+      GUI::LayoutHeader header = GUI::LayoutHeader();
+      memcpy(header.magic, "GUIB", 4);
+      header.version = LAYOUT_VERSION;
+      header.widgetCount = m_Widgets.size();
+      header.widgetOffset = sizeof(GUI::LayoutHeader);
+      header.styleCount = m_Styles.size();
+      header.styleOffset = header.widgetOffset+m_Widgets.size()*sizeof(GUI::LayoutWidget);
+      header.lookupCapacity = lookups.size();
+      header.lookupOffset = header.styleOffset+m_Styles.size()*sizeof(uint32_t);
+      header.stringOffset = header.lookupOffset+lookups.size()*sizeof(GUI::LayoutLookup);
+      header.stringSize = m_Strings.size();
+
+      FILE* file = fopen(fileName, "wb");
+      if (!file)
+      {
+        fprintf(stderr, "guic: cannot write %s\n", fileName);
+        return false;
+      }
+
+      fwrite(&header, sizeof(header), 1, file);
+      fwrite(m_Widgets.data(), sizeof(GUI::LayoutWidget), m_Widgets.size(), file);
+      fwrite(m_Styles.data(), sizeof(uint32_t), m_Styles.size(), file);
+      fwrite(lookups.data(), sizeof(GUI::LayoutLookup), lookups.size(), file);
+      fwrite(m_Strings.data(), 1, m_Strings.size(), file);
+
+      bool written = !ferror(file);
+      fclose(file);
+      return written;
+    }
+
+  private:
+    std::vector<Token> m_Tokens;
+    std::vector<GUI::LayoutWidget> m_Widgets;
+    std::vector<uint32_t> m_Styles;
+    std::string m_Strings;
+    std::map<std::string, uint32_t> m_Interned;
+    std::map<std::string, uint16_t> m_StyleHandles;
+    std::map<std::string, int> m_Ids;
+
+  private:
+    static uint32_t HashId(const char* id)
+    {
+      uint32_t hash = 2166136261u;
+      for (; *id; id++)
+        hash = (hash ^ (unsigned char)*id)*16777619u;
+
+      return hash ? hash : 1;
+    }
+
+    static bool Error(int line, const char* message)
+    {
+      fprintf(stderr, "guic: line %d: %s\n", line, message);
+      return false;
+    }
+
+    uint32_t Intern(const std::string& text)
+    {
+      if (text.empty())
+        return 0;
+
+      std::map<std::string, uint32_t>::iterator found = m_Interned.find(text);
+      if (found != m_Interned.end())
+        return found->second;
+
+      uint32_t offset = m_Strings.size();
+      m_Strings.append(text);
+      m_Strings.push_back('\0');
+      m_Interned[text] = offset;
+      return offset;
+    }
+
+    uint16_t InternStyle(const std::string& name)
+    {
+      std::map<std::string, uint16_t>::iterator found = m_StyleHandles.find(name);
+      if (found != m_StyleHandles.end())
+        return found->second;
+
+      uint16_t handle = m_Styles.size();
+      m_Styles.push_back(Intern(name));
+      m_StyleHandles[name] = handle;
+      return handle;
+    }
+
+    bool Tokenize(const std::string& source)
+    {
+      int line = 1;
+      for (size_t i = 0; i < source.length();)
+      {
+        char c = source[i];
+        if (c == '\n')
+        {
+          line++;
+          i++;
+        }
+        else if (c == ' ' || c == '\t' || c == '\r')
+        {
+          i++;
+        }
+        else if (c == '#')
+        {
+          while (i < source.length() && source[i] != '\n')
+            i++;
+        }
+        else if (c == '"')
+        {
+          Token token = { "", line, true };
+          for (i++; i < source.length() && source[i] != '"'; i++)
+          {
+            if (source[i] == '\n')
+              return Error(line, "unterminated string");
+            if (source[i] == '\\' && i+1 < source.length())
+            {
+              i++;
+              token.text += source[i] == 'n' ? '\n' : source[i];
+              continue;
+            }
+            token.text += source[i];
+          }
+
+          if (i == source.length())
+            return Error(line, "unterminated string");
+          i++;
+          m_Tokens.push_back(token);
+        }
+        else if (c == '{' || c == '}')
+        {
+          m_Tokens.push_back({ std::string(1, c), line, false });
+          i++;
+        }
+        else
+        {
+          size_t start = i;
+          while (i < source.length() && !strchr(" \t\r\n\"{}#", source[i]))
+            i++;
+          m_Tokens.push_back({ source.substr(start, i-start), line, false });
+        }
+      }
+
+      return true;
+    }
+
+    bool ParseWidget(size_t& i, std::vector<uint32_t>& stack)
+    {
+      const Token& type = m_Tokens[i];
+      GUI::LayoutWidget widget = GUI::LayoutWidget();
+
+      if (type.text == "panel")
+        widget.type = GUI::LAYOUT_WIDGET_PANEL;
+      else if (type.text == "label")
+        widget.type = GUI::LAYOUT_WIDGET_LABEL;
+      else if (type.text == "button")
+        widget.type = GUI::LAYOUT_WIDGET_BUTTON;
+      else if (type.text == "input")
+        widget.type = GUI::LAYOUT_WIDGET_INPUT;
+      else
+        return Error(type.line, ("unknown widget type '"+type.text+"'").c_str());
+
+      if (i+6 > m_Tokens.size() || m_Tokens[i+1].quoted)
+        return Error(type.line, "expected: <type> <id> <x> <y> <width> <height>");
+
+      const std::string& id = m_Tokens[i+1].text;
+      if (m_Ids.count(id))
+        return Error(type.line, ("duplicate id '"+id+"'").c_str());
+      m_Ids[id] = type.line;
+
+      float values[4];
+      for (int j = 0; j < 4; j++)
+      {
+        char* end;
+        values[j] = strtof(m_Tokens[i+2+j].text.c_str(), &end);
+        if (*end || m_Tokens[i+2+j].text.empty())
+          return Error(m_Tokens[i+2+j].line, "expected a number");
+      }
+
+      widget.id = Intern(id);
+      widget.parent = stack.empty() ? LAYOUT_NO_PARENT : stack.back();
+      widget.bounds = { values[0], values[1], values[2], values[3] };
+      if (!stack.empty())
+      {
+        widget.bounds.x += m_Widgets[stack.back()].bounds.x;
+        widget.bounds.y += m_Widgets[stack.back()].bounds.y;
+      }
+
+      for (i += 6; i < m_Tokens.size(); i++)
+      {
+        const Token& token = m_Tokens[i];
+        if (token.quoted)
+          widget.text = Intern(token.text);
+        else if (token.text.compare(0, 6, "style=") == 0)
+          widget.style = InternStyle(token.text.substr(6));
+        else
+          break;
+      }
+
+      m_Widgets.push_back(widget);
+      m_Widgets.back().next = m_Widgets.size();
+
+      if (i < m_Tokens.size() && m_Tokens[i].text == "{" && !m_Tokens[i].quoted)
+      {
+        stack.push_back(m_Widgets.size()-1);
+        i++;
+      }
+
+      return true;
+    }
+  };
+}
+
+int main(int argc, char** argv)
+{
+  if (argc != 3)
+  {
+    fprintf(stderr, "usage: guic <layout.gui> <layout.guib>\n");
+    return 1;
+  }
+
+  FILE* file = fopen(argv[1], "rb");
+  if (!file)
+  {
+    fprintf(stderr, "guic: cannot read %s\n", argv[1]);
+    return 1;
+  }
+
+  std::string source;
+  char buffer[4096];
+  for (size_t read; (read = fread(buffer, 1, sizeof(buffer), file));)
+    source.append(buffer, read);
+  fclose(file);
+
+  Compiler compiler;
+  if (!compiler.Parse(source) || !compiler.Write(argv[2]))
+    return 1;
+
+  return 0;
+}
@@ -0,0 +1,177 @@
+// Serves a live button and input to GUI::RemoteServer viewers without a window, every frame drawn by GUI::Software
+//
+//   headless [-j threads] [-s WIDTHxHEIGHT] <font.ttf> <address>
+//   headless assets/fonts/opensans.ttf unix:/tmp/gui.sock
+//   headless -j 4 -s 1280x720 assets/fonts/opensans.ttf 5900
+//
+// Connect with the viewer tool. The loop is main.cpp's with the viewers in place of raylib's input,
+// and the widgets recording into a TileRenderer through MouseState::tiles in place of drawing on the GPU.
+// Ctrl+C closes the server, which removes a Unix socket again.
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "../include/gui.hpp"
+
+namespace
+{
+  constexpr int FONT_SIZE = 20;
+  constexpr float FRAME_TIME = 1.0f/60;
+  constexpr Color BACKGROUND_COLOR = { 24, 24, 28, 255 };
+
+  volatile sig_atomic_t quit = 0;
+}
+
+static void Quit(int signal)
+{
+  (void)signal;
+  quit = 1;
+}
+
+static GUI::ButtonStyle MakeButtonStyle(Font font)
+{
+  GUI::ButtonStyle style = GUI::ButtonStyle();
+  style.baseBackgroundColor = { 50, 70, 160, 255 };
+  style.baseTextColor = { 255, 255, 255, 255 };
+  style.baseOutlineColor = { 90, 130, 255, 255 };
+  style.hoverBackgroundColor = { 70, 95, 200, 255 };
+  style.hoverTextColor = style.baseTextColor;
+  style.hoverOutlineColor = { 140, 170, 255, 255 };
+  style.font = font;
+  style.fontSize = FONT_SIZE;
+  style.textAlignment = GUI::TEXT_ALIGNMENT_CENTER;
+  style.roundness = 0.5f;
+  style.outlineThickness = 2;
+  style.outlineDistance = 2;
+  style.hoverScale = 1.05f;
+  style.hoverOutlineOffset = 2;
+  style.transitionTime = 0.2f;
+  return style;
+}
+
+static GUI::InputStyle MakeInputStyle(Font font)
+{
+  GUI::InputStyle style = GUI::InputStyle();
+  style.baseBackgroundColor = { 36, 36, 42, 255 };
+  style.baseOutlineColor = { 90, 90, 110, 255 };
+  style.baseTextColor = { 240, 240, 240, 255 };
+  style.basePlaceholderColor = { 130, 130, 140, 255 };
+  style.hoverBackgroundColor = { 44, 44, 52, 255 };
+  style.hoverOutlineColor = { 120, 120, 140, 255 };
+  style.hoverTextColor = style.baseTextColor;
+  style.hoverPlaceholderColor = style.basePlaceholderColor;
+  style.selectedBackgroundColor = { 20, 20, 24, 255 };
+  style.selectedOutlineColor = { 90, 130, 255, 255 };
+  style.selectedTextColor = { 255, 255, 255, 255 };
+  style.highlightColor = { 80, 120, 255, 100 };
+  style.font = font;
+  style.fontSize = FONT_SIZE;
+  style.roundness = 0.3f;
+  style.outlineThickness = 2;
+  style.outlineDistance = 2;
+  style.transitionTime = 0.2f;
+  return style;
+}
+
+int main(int argc, char** argv)
+{
+  int arg = 1;
+  size_t threads = 0;
+  int width = 800;
+  int height = 450;
+  for (; arg+1 < argc && argv[arg][0] == '-'; arg += 2)
+  {
+    if (!strcmp(argv[arg], "-j"))
+      threads = strtoul(argv[arg+1], nullptr, 10);
+    else if (strcmp(argv[arg], "-s") || sscanf(argv[arg+1], "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0)
+      break;
+  }
+
+  if (argc-arg != 2 || argv[arg][0] == '-')
+  {
+    fprintf(stderr, "usage: headless [-j threads] [-s WIDTHxHEIGHT] <font.ttf> <unix:path | [host:]port>\n");
+    return 1;
+  }
+
+  SetTraceLogLevel(LOG_WARNING);
+
+  Font font;
+  Image atlas;
+  if (!GUI::Software::LoadFont(argv[arg], FONT_SIZE, font, atlas))
+  {
+    fprintf(stderr, "headless: cannot load %s\n", argv[arg]);
+    return 1;
+  }
+
+  GUI::RemoteServer server;
+  if (!server.Listen(argv[arg+1]))
+  {
+    fprintf(stderr, "headless: cannot listen on %s\n", argv[arg+1]);
+    GUI::Software::UnloadFont(font, atlas);
+    return 1;
+  }
+  signal(SIGINT, Quit);
+  signal(SIGTERM, Quit);
+
+  {
+    Image frame = GenImageColor(width, height, BACKGROUND_COLOR);
+    GUI::TileRenderer tiles;
+    tiles.AddFont(font, atlas);
+    std::unique_ptr<GUI::ThreadPool> pool;
+    if (threads > 1)
+      pool.reset(new GUI::ThreadPool(threads));
+
+    GUI::Animator animator;
+    GUI::ClipStack clip;
+    GUI::FocusManager focus;
+    GUI::EventQueue events;
+    GUI::MouseState mouseState = GUI::MouseState();
+    mouseState.animator = &animator;
+    mouseState.clip = &clip;
+    mouseState.focus = &focus;
+    mouseState.events = &events;
+    mouseState.tiles = &tiles;
+
+    GUI::Input input({ 40, 40, 400, 44 }, MakeInputStyle(font), "Type on the viewer");
+    GUI::Button button({ 460, 40, 140, 44 }, MakeButtonStyle(font), "Clear");
+
+    // raylib's clock only runs with a window, frames are paced on the steady clock
+    auto next = std::chrono::steady_clock::now();
+    while (!quit)
+    {
+      animator.Update(FRAME_TIME);
+
+      mouseState.clicked = false;
+      mouseState.cursor = MOUSE_CURSOR_DEFAULT;
+      focus.BeginFrame();
+      server.Poll(mouseState, &focus);
+
+      tiles.Clear();
+      tiles.DrawRectangle({ 0, 0, (float)width, (float)height }, BACKGROUND_COLOR);
+      input.UpdateAndRender(mouseState);
+      if (button.UpdateAndRender(mouseState))
+        input.SetText("");
+      focus.EndFrame(mouseState);
+      events.Dispatch();
+
+      tiles.Render(frame, pool.get());
+      server.SendFrame(frame);
+
+      next += std::chrono::microseconds((long long)(FRAME_TIME*1000000));
+      std::this_thread::sleep_until(next);
+    }
+
+    // Closing releases the keys viewers still hold through focus, so it happens before focus goes away
+    server.Close();
+    UnloadImage(frame);
+  }
+
+  GUI::Software::UnloadFont(font, atlas);
+  return 0;
+}
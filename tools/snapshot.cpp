@@ -0,0 +1,172 @@
+// Renders compiled layouts offscreen to PNG without opening a window, one GUI::Snapshot per layout on a pool of threads
+//
+//   snapshot [-j threads] <font.ttf> <output dir> <layout.guib>...
+//   snapshot -j 8 assets/fonts/opensans.ttf docs/screens build/layouts/*.guib
+//
+// Each layout is written to <output dir>/<layout name>.png, sized to fit its widgets.
+// Buttons and inputs use the styles below whatever style they name, panels and labels are not drawn.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/gui.hpp"
+
+namespace
+{
+  constexpr int FONT_SIZE = 20;
+  constexpr float MARGIN = 20;
+  constexpr Color BACKGROUND_COLOR = { 24, 24, 28, 255 };
+}
+
+static GUI::ButtonStyle MakeButtonStyle(Font font)
+{
+  GUI::ButtonStyle style = GUI::ButtonStyle();
+  style.baseBackgroundColor = { 50, 70, 160, 255 };
+  style.baseTextColor = { 255, 255, 255, 255 };
+  style.baseOutlineColor = { 90, 130, 255, 255 };
+  style.hoverBackgroundColor = style.baseBackgroundColor;
+  style.hoverTextColor = style.baseTextColor;
+  style.hoverOutlineColor = style.baseOutlineColor;
+  style.font = font;
+  style.fontSize = FONT_SIZE;
+  style.textAlignment = GUI::TEXT_ALIGNMENT_CENTER;
+  style.roundness = 0.5f;
+  style.outlineThickness = 2;
+  style.hoverScale = 1;
+  return style;
+}
+
+static GUI::InputStyle MakeInputStyle(Font font)
+{
+  GUI::InputStyle style = GUI::InputStyle();
+  style.baseBackgroundColor = { 36, 36, 42, 255 };
+  style.baseOutlineColor = { 90, 90, 110, 255 };
+  style.baseTextColor = { 200, 200, 210, 255 };
+  style.basePlaceholderColor = { 120, 120, 130, 255 };
+  style.hoverBackgroundColor = style.baseBackgroundColor;
+  style.hoverOutlineColor = style.baseOutlineColor;
+  style.hoverTextColor = style.baseTextColor;
+  style.hoverPlaceholderColor = style.basePlaceholderColor;
+  style.selectedBackgroundColor = style.baseBackgroundColor;
+  style.selectedOutlineColor = style.baseOutlineColor;
+  style.selectedTextColor = style.baseTextColor;
+  style.highlightColor = { 80, 120, 255, 100 };
+  style.font = font;
+  style.fontSize = FONT_SIZE;
+  style.roundness = 0.3f;
+  style.outlineThickness = 2;
+  return style;
+}
+
+// <output dir>/<layout file name without extension>.png, built on the main thread since raylib's path helpers share static buffers
+static std::string OutputName(const char* directory, const char* layout)
+{
+  const char* name = strrchr(layout, '/');
+  const char* backslash = strrchr(layout, '\\');
+  if (backslash && (!name || backslash > name))
+    name = backslash;
+  name = name ? name+1 : layout;
+
+  const char* extension = strrchr(name, '.');
+  std::string output(directory);
+  if (!output.empty() && output.back() != '/')
+    output.push_back('/');
+  output.append(name, extension && extension != name ? extension-name : strlen(name));
+  output.append(".png");
+  return output;
+}
+
+// Loads, builds, renders and writes one layout, everything it touches belongs to this job
+static bool RenderLayout(const char* fileName, const std::string& output, Font font, const Image& atlas, const GUI::ButtonStyle& buttonStyle, const GUI::InputStyle& inputStyle)
+{
+  GUI::Layout layout;
+  if (!layout.Load(fileName))
+  {
+    fprintf(stderr, "snapshot: cannot load %s\n", fileName);
+    return false;
+  }
+
+  float width = 0;
+  float height = 0;
+  const GUI::LayoutWidget* widgets = layout.GetWidgets();
+  for (size_t i = 0; i < layout.GetWidgetCount(); i++)
+  {
+    if (widgets[i].bounds.x+widgets[i].bounds.width > width)
+      width = widgets[i].bounds.x+widgets[i].bounds.width;
+    if (widgets[i].bounds.y+widgets[i].bounds.height > height)
+      height = widgets[i].bounds.y+widgets[i].bounds.height;
+  }
+
+  GUI::Snapshot snapshot(width+MARGIN, height+MARGIN, BACKGROUND_COLOR);
+  snapshot.AddFont(font, atlas);
+  for (size_t i = 0; i < layout.GetWidgetCount(); i++)
+  {
+    const GUI::LayoutWidget& widget = widgets[i];
+    if (widget.type == GUI::LAYOUT_WIDGET_BUTTON)
+      snapshot.AddButton(widget.bounds, buttonStyle, layout.GetString(widget.text));
+    else if (widget.type == GUI::LAYOUT_WIDGET_INPUT)
+      snapshot.AddInput(widget.bounds, inputStyle, layout.GetString(widget.text));
+  }
+
+  snapshot.Render();
+  if (!snapshot.Export(output.c_str()))
+  {
+    fprintf(stderr, "snapshot: cannot write %s\n", output.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  int arg = 1;
+  size_t threads = 0;
+  if (argc > 2 && !strcmp(argv[1], "-j"))
+  {
+    threads = strtoul(argv[2], nullptr, 10);
+    arg = 3;
+  }
+
+  if (argc-arg < 3)
+  {
+    fprintf(stderr, "usage: snapshot [-j threads] <font.ttf> <output dir> <layout.guib>...\n");
+    return 1;
+  }
+
+  SetTraceLogLevel(LOG_WARNING);
+  Font font;
+  Image atlas;
+  if (!GUI::Software::LoadFont(argv[arg], FONT_SIZE, font, atlas))
+  {
+    fprintf(stderr, "snapshot: cannot load %s\n", argv[arg]);
+    return 1;
+  }
+
+  // The font and styles are shared read-only, each job builds its own layout, widgets and image
+  GUI::ButtonStyle buttonStyle = MakeButtonStyle(font);
+  GUI::InputStyle inputStyle = MakeInputStyle(font);
+  std::atomic<int> failures(0);
+  {
+    GUI::ThreadPool pool(threads ? threads : std::thread::hardware_concurrency());
+    for (int i = arg+2; i < argc; i++)
+    {
+      const char* fileName = argv[i];
+      std::string output = OutputName(argv[arg+1], fileName);
+      pool.Submit([fileName, output, font, &atlas, &buttonStyle, &inputStyle, &failures]
+      {
+        if (!RenderLayout(fileName, output, font, atlas, buttonStyle, inputStyle))
+          failures++;
+      });
+    }
+
+    pool.Wait();
+  }
+
+  GUI::Software::UnloadFont(font, atlas);
+
+  int total = argc-arg-2;
+  printf("snapshot: %d of %d layouts written\n", total-failures.load(), total);
+  return failures.load() ? 1 : 0;
+}
@@ -0,0 +1,182 @@
+// Times GUI::Software rendering a dashboard frame, on one core or binned into tiles across a thread pool
+//
+//   softbench [-j threads] [-s WIDTHxHEIGHT] <font.ttf> [frames] [output.png]
+//   softbench assets/fonts/opensans.ttf 200 frame.png
+//   softbench -j 16 -s 7680x4320 assets/fonts/opensans.ttf 50
+//
+// Build with CMAKE_BUILD_TYPE=Release and GUI_ENABLE_AVX2 to compare the SSE2 and AVX2 kernels.
+// The dashboard repeats to fill frames larger than 1920x1080.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "../include/gui.hpp"
+
+namespace
+{
+  constexpr int DASHBOARD_WIDTH = 1920;
+  constexpr int DASHBOARD_HEIGHT = 1080;
+  constexpr int CARD_COLUMNS = 6;
+  constexpr int CARD_ROWS = 5;
+  constexpr float FONT_SIZE = 20;
+}
+
+// Draws straight into the frame, the TileRenderer has the same calls without the image
+struct ImmediateCanvas
+{
+  Image& frame;
+
+  void DrawRectangle(Rectangle rec, Color color) { GUI::Software::DrawRectangle(frame, rec, color); }
+  void DrawRectangleRounded(Rectangle rec, float roundness, Color color) { GUI::Software::DrawRectangleRounded(frame, rec, roundness, color); }
+  void DrawRectangleRoundedLines(Rectangle rec, float roundness, float lineThickness, Color color) { GUI::Software::DrawRectangleRoundedLines(frame, rec, roundness, lineThickness, color); }
+  void DrawTextEx(const Image& atlas, Font font, const char* text, Vector2 position, float fontSize, float spacing, Color tint) { GUI::Software::DrawTextEx(frame, atlas, font, text, position, fontSize, spacing, tint); }
+};
+
+// Same shapes and order as Button::RenderSoftware and the Input render, spread over a sidebar, a search field and a grid of cards
+template <typename Canvas>
+static void RenderDashboard(Canvas& canvas, const Image& atlas, Font font, float x, float y)
+{
+  canvas.DrawRectangle({ x, y, DASHBOARD_WIDTH, DASHBOARD_HEIGHT }, { 24, 24, 28, 255 });
+  canvas.DrawRectangle({ x, y, 260, DASHBOARD_HEIGHT }, { 32, 32, 38, 255 });
+
+  static const char* menu[] = { "Overview", "Sessions", "Devices", "Alerts", "Reports", "Settings" };
+  for (int i = 0; i < 6; i++)
+  {
+    Rectangle bounds = { x+20, y+100+i*60, 220, 44 };
+    canvas.DrawRectangleRoundedLines(bounds, 0.5f, 2, { 70, 70, 84, 255 });
+    canvas.DrawRectangleRounded(bounds, 0.5f, i ? Color{ 40, 40, 48, 255 } : Color{ 60, 90, 200, 255 });
+    canvas.DrawTextEx(atlas, font, menu[i], { bounds.x+16, bounds.y+12 }, FONT_SIZE, GUI::SPACING, { 230, 230, 235, 255 });
+  }
+
+  // Search field with a selection highlight and the caret
+  Rectangle search = { x+300, y+30, 700, 48 };
+  canvas.DrawRectangleRoundedLines(search, 0.3f, 2, { 90, 90, 110, 255 });
+  canvas.DrawRectangleRounded(search, 0.3f, { 36, 36, 42, 255 });
+  canvas.DrawRectangle({ search.x+14, search.y+12, 120, 24 }, { 80, 120, 255, 100 });
+  canvas.DrawTextEx(atlas, font, "cpu > 80% and region = eu-west", { search.x+16, search.y+14 }, FONT_SIZE, GUI::SPACING, { 240, 240, 240, 255 });
+  canvas.DrawRectangle({ search.x+330, search.y+12, 2, 24 }, { 255, 255, 255, 255 });
+
+  for (int row = 0; row < CARD_ROWS; row++)
+  {
+    for (int column = 0; column < CARD_COLUMNS; column++)
+    {
+      Rectangle card = { x+300+column*266, y+110+row*190, 246, 170 };
+      canvas.DrawRectangleRoundedLines(card, 0.15f, 1, { 60, 60, 72, 255 });
+      canvas.DrawRectangleRounded(card, 0.15f, { 34, 34, 40, 235 });
+      canvas.DrawTextEx(atlas, font, "Requests per second", { card.x+16, card.y+16 }, FONT_SIZE*0.8f, GUI::SPACING, { 160, 160, 170, 255 });
+      canvas.DrawTextEx(atlas, font, "12,480", { card.x+16, card.y+44 }, FONT_SIZE*2, GUI::SPACING, { 245, 245, 250, 255 });
+
+      Rectangle button = { card.x+16, card.y+116, 100, 36 };
+      canvas.DrawRectangleRounded({ button.x-2, button.y-2, button.width+4, button.height+4 }, 0.5f, { 90, 130, 255, 255 });
+      canvas.DrawRectangleRounded(button, 0.5f, { 50, 70, 160, 255 });
+      canvas.DrawTextEx(atlas, font, "Details", { button.x+20, button.y+8 }, FONT_SIZE, GUI::SPACING, { 255, 255, 255, 255 });
+    }
+  }
+}
+
+template <typename Canvas>
+static void RenderFrame(Canvas& canvas, const Image& atlas, Font font, int width, int height)
+{
+  for (int y = 0; y < height; y += DASHBOARD_HEIGHT)
+  {
+    for (int x = 0; x < width; x += DASHBOARD_WIDTH)
+      RenderDashboard(canvas, atlas, font, x, y);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int arg = 1;
+  size_t threads = 0;
+  int width = DASHBOARD_WIDTH;
+  int height = DASHBOARD_HEIGHT;
+  for (; arg+1 < argc && argv[arg][0] == '-'; arg += 2)
+  {
+    if (!strcmp(argv[arg], "-j"))
+      threads = strtoul(argv[arg+1], nullptr, 10);
+    else if (strcmp(argv[arg], "-s") || sscanf(argv[arg+1], "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0)
+      break;
+  }
+
+  if (argc-arg < 1 || argc-arg > 3 || argv[arg][0] == '-')
+  {
+    fprintf(stderr, "usage: softbench [-j threads] [-s WIDTHxHEIGHT] <font.ttf> [frames] [output.png]\n");
+    return 1;
+  }
+
+  int frames = argc-arg > 1 ? atoi(argv[arg+1]) : 100;
+  if (frames <= 0)
+  {
+    fprintf(stderr, "softbench: frames must be positive\n");
+    return 1;
+  }
+
+  SetTraceLogLevel(LOG_WARNING);
+  Font font;
+  Image atlas;
+  if (!GUI::Software::LoadFont(argv[arg], (int)FONT_SIZE, font, atlas))
+  {
+    fprintf(stderr, "softbench: cannot load %s\n", argv[arg]);
+    return 1;
+  }
+
+  Image frame = GenImageColor(width, height, BLANK);
+  ImmediateCanvas canvas = { frame };
+  std::unique_ptr<GUI::ThreadPool> pool;
+  GUI::TileRenderer tiles;
+  if (threads)
+    pool.reset(new GUI::ThreadPool(threads));
+
+  // The first frame warms the caches and is not timed
+  double best = 0;
+  double total = 0;
+  for (int i = -1; i < frames; i++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    if (pool)
+    {
+      tiles.Clear();
+      RenderFrame(tiles, atlas, font, width, height);
+      tiles.Render(frame, pool.get());
+    }
+    else
+    {
+      RenderFrame(canvas, atlas, font, width, height);
+    }
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()-start).count();
+
+    if (i < 0)
+      continue;
+    total += elapsed;
+    if (!i || elapsed < best)
+      best = elapsed;
+  }
+
+#if defined(__AVX2__)
+  const char* kernels = "AVX2";
+#elif defined(__SSE2__) || defined(_M_X64)
+  const char* kernels = "SSE2";
+#else
+  const char* kernels = "scalar";
+#endif
+  printf("softbench: %dx%d, %d frames, %s kernels: %.3f ms average, %.3f ms best\n", width, height, frames, kernels, total/frames, best);
+
+  if (pool)
+  {
+    // Stats of the last frame, a busy tile far above the average is what limits scaling
+    const GUI::TileStats& stats = tiles.GetStats();
+    printf("softbench: %zu threads, %zu of %zu %dx%d tiles drawn, %zu commands binned %zu times\n", stats.threadCount, stats.activeTileCount, stats.tileCount, tiles.GetTileSize(), tiles.GetTileSize(), stats.commandCount, stats.binnedCount);
+    printf("softbench: binning %.3f ms, rasterizing %.3f ms, %.3f ms average and %.3f ms slowest tile\n", stats.binMilliseconds, stats.renderMilliseconds, stats.averageTileMilliseconds, stats.maxTileMilliseconds);
+  }
+
+  bool written = argc-arg < 3 || ExportImage(frame, argv[arg+2]);
+  if (!written)
+    fprintf(stderr, "softbench: cannot write %s\n", argv[arg+2]);
+
+  UnloadImage(frame);
+  GUI::Software::UnloadFont(font, atlas);
+  return written ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+// Reference client for GUI::RemoteServer, shows the streamed frames in a window and sends the mouse and keyboard back
+//
+//   viewer <address>
+//   viewer unix:/tmp/gui.sock
+//   viewer 5900
+//
+// The address is the one the server listens on, the window takes the size of the server's frames.
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "../include/gui.hpp"
+
+int main(int argc, char** argv)
+{
+  if (argc != 2)
+  {
+    fprintf(stderr, "usage: viewer <unix:path | [host:]port>\n");
+    return 1;
+  }
+
+  GUI::RemoteClient client;
+  if (!client.Connect(argv[1]))
+  {
+    fprintf(stderr, "viewer: cannot connect to %s\n", argv[1]);
+    return 1;
+  }
+
+  InitWindow(800, 450, "GUI viewer");
+  SetTargetFPS(60);
+  SetExitKey(KEY_NULL);
+
+  Image frame = Image();
+  Texture2D texture = Texture2D();
+  Vector2 mousePosition = { -1, -1 };
+  bool mouseDown = false;
+  std::vector<int> keysDown;
+  size_t receivedBytes = 0;
+  double rateTime = GetTime();
+
+  while (!WindowShouldClose())
+  {
+    if (client.Receive(frame))
+    {
+      if (texture.width != frame.width || texture.height != frame.height)
+      {
+        if (texture.id)
+          UnloadTexture(texture);
+        texture = LoadTextureFromImage(frame);
+        SetWindowSize(frame.width, frame.height);
+      }
+      else
+      {
+        UpdateTexture(texture, frame.data);
+      }
+    }
+
+    if (client.IsConnected())
+    {
+      // Only changes are sent, the server keeps the last state
+      Vector2 position = GetMousePosition();
+      bool down = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+      if (position.x != mousePosition.x || position.y != mousePosition.y || down != mouseDown)
+      {
+        client.SendMouse(position, down);
+        mousePosition = position;
+        mouseDown = down;
+      }
+
+      for (int key = GetKeyPressed(); key; key = GetKeyPressed())
+      {
+        client.SendKey(key, true);
+        keysDown.push_back(key);
+      }
+
+      for (size_t i = keysDown.size(); i--;)
+      {
+        if (!IsKeyDown(keysDown[i]))
+        {
+          client.SendKey(keysDown[i], false);
+          keysDown.erase(keysDown.begin()+i);
+        }
+      }
+
+      for (int codepoint = GetCharPressed(); codepoint; codepoint = GetCharPressed())
+        client.SendChar(codepoint);
+    }
+
+    // Bandwidth in the title, it should follow what changes on screen and not the window size
+    if (GetTime()-rateTime >= 1)
+    {
+      size_t bytes = client.GetReceivedBytes();
+      SetWindowTitle(TextFormat("GUI viewer - %s - %.1f KB/s", argv[1], (bytes-receivedBytes)/1024.0/(GetTime()-rateTime)));
+      receivedBytes = bytes;
+      rateTime = GetTime();
+    }
+
+    BeginDrawing();
+    ClearBackground(BLACK);
+    if (texture.id)
+      DrawTexture(texture, 0, 0, WHITE);
+    if (!client.IsConnected())
+      DrawText("Disconnected", 10, 10, 20, RED);
+    EndDrawing();
+  }
+
+  if (texture.id)
+    UnloadTexture(texture);
+  if (frame.data)
+    UnloadImage(frame);
+  CloseWindow();
+  return 0;
+}